@@ -0,0 +1,293 @@
+#include <new>
+#include <time.h>
+#include "benchmark.h"
+#include "amigascreen.h"
+#include "button.h"
+#include "calendar.h"
+#include "damagedrectmanager.h"
+#include "gradient.h"
+#include "hardware.h"
+#include "label.h"
+
+// Count every heap allocation made by the process so that each frame's
+// allocations can be reported
+static u32 allocationCount = 0;
+
+void* operator new(size_t size) {
+	++allocationCount;
+
+	void* data = malloc(size > 0 ? size : 1);
+	if (data == NULL) abort();
+
+	return data;
+}
+
+void* operator new[](size_t size) {
+	return operator new(size);
+}
+
+void operator delete(void* data) throw() {
+	free(data);
+}
+
+void operator delete[](void* data) throw() {
+	free(data);
+}
+
+#if __cplusplus >= 201402L
+
+void operator delete(void* data, size_t size) throw() {
+	free(data);
+}
+
+void operator delete[](void* data, size_t size) throw() {
+	free(data);
+}
+
+#endif
+
+/**
+ * Get a monotonic timestamp.
+ * @return The current time in microseconds.
+ */
+static u64 getMicroseconds() {
+	timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+
+	return ((u64)time.tv_sec * 1000000) + (time.tv_nsec / 1000);
+}
+
+void Benchmark::startup() {
+
+	// Top screen is static; it is only redrawn if something damages it
+	AmigaScreen* topScreen = new AmigaScreen("Top Screen", true, true);
+	addGadget(topScreen);
+	topScreen->flipToTopScreen();
+	topScreen->addGadget(new Gradient(0, 13, 256, 179, woopsiRGB(0, 0, 20), woopsiRGB(20, 0, 0)));
+
+	AmigaWindow* calendarWindow = new AmigaWindow(20, 20, 160, 130, "Calendar", true, true);
+	topScreen->addGadget(calendarWindow);
+	calendarWindow->addGadget(new Calendar(2, 2, 140, 100, 1, 1, 2010));
+
+	AmigaScreen* screen = new AmigaScreen("Benchmark", true, true);
+	addGadget(screen);
+
+	_widgetWindow = new AmigaWindow(0, 13, 196, 179, "Widgets", true, true);
+	screen->addGadget(_widgetWindow);
+
+	_listBox = new ScrollingListBox(2, 2, 90, 96);
+
+	char buffer[16];
+	for (s32 i = 0; i < 200; ++i) {
+		sprintf(buffer, "Item %d", i);
+		_listBox->addOption(buffer, i);
+	}
+
+	_widgetWindow->addGadget(_listBox);
+
+	_panel = new ScrollingPanel(96, 2, 90, 96);
+	_panel->setCanvasWidth(400);
+	_panel->setCanvasHeight(400);
+
+	for (s32 y = 0; y < 8; ++y) {
+		for (s32 x = 0; x < 4; ++x) {
+			sprintf(buffer, "%d,%d", x, y);
+			_panel->addGadget(new Button(x * 50, y * 20, 48, 18, buffer));
+		}
+	}
+
+	_widgetWindow->addGadget(_panel);
+
+	_textBox = new MultiLineTextBox(2, 100, 184, 58, "Benchmark text.", 0);
+	_widgetWindow->addGadget(_textBox);
+
+	_dragWindow = new AmigaWindow(120, 40, 120, 80, "Drag Me", true, true);
+	screen->addGadget(_dragWindow);
+	_dragWindow->addGadget(new Label(2, 2, 100, 14, "Label"));
+	_dragWindow->addGadget(new Button(2, 20, 100, 20, "Button"));
+}
+
+int Benchmark::main(int argc, char* argv[]) {
+
+	bool verbose = (argc > 1) && (strcmp(argv[1], "-v") == 0);
+
+	startup();
+
+	// Draw the initial display so that the first phase starts from a clean
+	// state
+	Hardware::setStylusState(0, 0, false);
+	processOneVBL(this);
+
+	PhaseStats stats[PHASE_COUNT];
+
+	if (verbose) printf("phase frame time_us rects pixels allocs\n");
+
+	for (s32 phase = 0; phase < PHASE_COUNT; ++phase) {
+		PhaseStats& phaseStats = stats[phase];
+
+		phaseStats.frames = 0;
+		phaseStats.totalTime = 0;
+		phaseStats.minTime = 0xffffffff;
+		phaseStats.maxTime = 0;
+		phaseStats.rects = 0;
+		phaseStats.pixels = 0;
+		phaseStats.allocations = 0;
+
+		for (s32 frame = 0; frame < getPhaseFrameCount((Phase)phase); ++frame) {
+			u32 allocations = allocationCount;
+			u32 rects = _damagedRectManager->getRedrawnRectCount();
+			u32 pixels = _damagedRectManager->getRedrawnPixelCount();
+			u64 start = getMicroseconds();
+
+			scriptFrame((Phase)phase, frame);
+			processOneVBL(this);
+
+			u32 time = (u32)(getMicroseconds() - start);
+			allocations = allocationCount - allocations;
+
+			rects = _damagedRectManager->getRedrawnRectCount() - rects;
+			pixels = _damagedRectManager->getRedrawnPixelCount() - pixels;
+
+			++phaseStats.frames;
+			phaseStats.totalTime += time;
+			if (time < phaseStats.minTime) phaseStats.minTime = time;
+			if (time > phaseStats.maxTime) phaseStats.maxTime = time;
+			phaseStats.rects += rects;
+			phaseStats.pixels += pixels;
+			phaseStats.allocations += allocations;
+
+			if (verbose) printf("%s %d %u %u %u %u\n", getPhaseName((Phase)phase), frame, time, rects, pixels, allocations);
+		}
+	}
+
+	printf("%-14s %6s %9s %9s %9s %7s %9s %7s\n", "phase", "frames", "mean_us", "min_us", "max_us", "rects", "pixels", "allocs");
+
+	for (s32 phase = 0; phase < PHASE_COUNT; ++phase) {
+		const PhaseStats& phaseStats = stats[phase];
+
+		printf("%-14s %6u %9u %9u %9u %7u %9u %7u\n",
+			   getPhaseName((Phase)phase),
+			   phaseStats.frames,
+			   (u32)(phaseStats.totalTime / phaseStats.frames),
+			   phaseStats.minTime,
+			   phaseStats.maxTime,
+			   phaseStats.rects,
+			   phaseStats.pixels,
+			   phaseStats.allocations);
+	}
+
+	printf("checksum %08x\n", getDisplayChecksum());
+
+	shutdown();
+
+	return 0;
+}
+
+const char* Benchmark::getPhaseName(Phase phase) const {
+	switch (phase) {
+		case PHASE_IDLE:
+			return "idle";
+		case PHASE_WINDOW_DRAG:
+			return "window_drag";
+		case PHASE_LIST_DRAG:
+			return "list_drag";
+		case PHASE_PANEL_SCROLL:
+			return "panel_scroll";
+		case PHASE_TEXT_APPEND:
+			return "text_append";
+		case PHASE_LIST_SELECT:
+			return "list_select";
+		case PHASE_WINDOW_RAISE:
+			return "window_raise";
+		default:
+			return "";
+	}
+}
+
+s32 Benchmark::getPhaseFrameCount(Phase phase) const {
+	switch (phase) {
+		case PHASE_IDLE:
+			return 30;
+		case PHASE_WINDOW_DRAG:
+		case PHASE_LIST_DRAG:
+			return 62;
+		case PHASE_WINDOW_RAISE:
+			return 40;
+		default:
+			return 60;
+	}
+}
+
+void Benchmark::scriptFrame(Phase phase, s32 frame) {
+
+	// Stylus is released unless the script says otherwise
+	Hardware::setStylusState(0, 0, false);
+
+	switch (phase) {
+		case PHASE_IDLE:
+			break;
+
+		case PHASE_WINDOW_DRAG:
+
+			// Grab the title bar, move it down and left for 60 frames, then
+			// release it
+			if (frame < getPhaseFrameCount(phase) - 1) {
+				s16 x = 150 - frame;
+				s16 y = 45 + (frame / 2);
+
+				Hardware::setStylusState(x, y, true);
+			}
+			break;
+
+		case PHASE_LIST_DRAG:
+			if (frame < getPhaseFrameCount(phase) - 1) {
+				s16 x = _listBox->getX() + 20;
+				s16 y = _listBox->getY() + _listBox->getHeight() - 4 - frame;
+
+				Hardware::setStylusState(x, y, true);
+			}
+			break;
+
+		case PHASE_PANEL_SCROLL:
+			_panel->scroll(frame < 30 ? -2 : 2, frame < 30 ? -3 : 3);
+			break;
+
+		case PHASE_TEXT_APPEND:
+			_textBox->appendText("The quick brown fox jumps over the lazy dog. ");
+			break;
+
+		case PHASE_LIST_SELECT:
+			_listBox->setSelectedIndex(frame % 12);
+			break;
+
+		case PHASE_WINDOW_RAISE:
+
+			// Click the widget window's depth button every other frame, which
+			// alternately sends it behind the drag window and brings it back
+			if (frame % 2 == 0) pressDepthButton(_widgetWindow);
+			break;
+
+		default:
+			break;
+	}
+}
+
+void Benchmark::pressDepthButton(const AmigaWindow* window) {
+	Hardware::setStylusState(window->getX() + window->getWidth() - (WINDOW_DEPTH_BUTTON_WIDTH / 2), window->getY() + (WINDOW_TITLE_HEIGHT / 2), true);
+}
+
+u32 Benchmark::getDisplayChecksum() const {
+
+	// FNV-1a over both framebuffers
+	u32 checksum = 2166136261u;
+	const u16* buffers[2] = { Hardware::getTopBuffer()->getData(), Hardware::getBottomBuffer()->getData() };
+
+	for (s32 i = 0; i < 2; ++i) {
+		for (s32 j = 0; j < SCREEN_WIDTH * SCREEN_HEIGHT; ++j) {
+			checksum ^= buffers[i][j];
+			checksum *= 16777619u;
+		}
+	}
+
+	return checksum;
+}
@@ -0,0 +1,109 @@
+#ifndef _BENCHMARK_H_
+#define _BENCHMARK_H_
+
+#include "woopsi.h"
+#include "amigawindow.h"
+#include "multilinetextbox.h"
+#include "scrollinglistbox.h"
+#include "scrollingpanel.h"
+
+using namespace WoopsiUI;
+
+/**
+ * Headless benchmark for the complete input, damage and redraw pipeline.
+ * Builds a fixed gadget tree, drives it through a series of scripted phases
+ * and reports how long each call to processOneVBL() took along with the
+ * number of damaged rects, redrawn pixels and heap allocations per phase.
+ * Apart from the timings the output is deterministic, so it can be compared
+ * between builds to catch regressions.
+ *
+ * Must be built against the headless platform headers (see the makefile).
+ */
+class Benchmark : public Woopsi {
+public:
+
+	/**
+	 * Run the benchmark.  Pass "-v" to print statistics for every frame as
+	 * well as the per-phase summary.
+	 * @param argc Number of command line arguments.
+	 * @param argv Command line arguments.
+	 * @return 0 on success.
+	 */
+	int main(int argc, char* argv[]);
+
+private:
+
+	/**
+	 * Scripted phases that the benchmark runs through in order.
+	 */
+	typedef enum {
+		PHASE_IDLE = 0,						/**< No input. */
+		PHASE_WINDOW_DRAG = 1,				/**< Drag a window across another. */
+		PHASE_LIST_DRAG = 2,				/**< Drag-scroll a long list. */
+		PHASE_PANEL_SCROLL = 3,				/**< Scroll a panel full of buttons. */
+		PHASE_TEXT_APPEND = 4,				/**< Append to a multiline text box. */
+		PHASE_LIST_SELECT = 5,				/**< Change the selected list item. */
+		PHASE_WINDOW_RAISE = 6,				/**< Click windows to change depth. */
+		PHASE_COUNT = 7						/**< Number of phases. */
+	} Phase;
+
+	/**
+	 * Statistics gathered for a phase.
+	 */
+	typedef struct {
+		u32 frames;							/**< Number of frames run. */
+		u64 totalTime;						/**< Total time in microseconds. */
+		u32 minTime;						/**< Fastest frame in microseconds. */
+		u32 maxTime;						/**< Slowest frame in microseconds. */
+		u32 rects;							/**< Total damaged rects redrawn. */
+		u32 pixels;							/**< Total pixels redrawn. */
+		u32 allocations;					/**< Total heap allocations. */
+	} PhaseStats;
+
+	AmigaWindow* _widgetWindow;				/**< Window containing the widgets. */
+	AmigaWindow* _dragWindow;				/**< Window that gets dragged around. */
+	ScrollingListBox* _listBox;				/**< Long list. */
+	ScrollingPanel* _panel;					/**< Panel containing many buttons. */
+	MultiLineTextBox* _textBox;				/**< Text box that grows. */
+
+	/**
+	 * Create the gadget tree.
+	 */
+	void startup();
+
+	/**
+	 * Get the name of a phase.
+	 * @param phase The phase.
+	 * @return The name of the phase.
+	 */
+	const char* getPhaseName(Phase phase) const;
+
+	/**
+	 * Get the number of frames that a phase runs for.
+	 * @param phase The phase.
+	 * @return The number of frames in the phase.
+	 */
+	s32 getPhaseFrameCount(Phase phase) const;
+
+	/**
+	 * Set up the input and perform any gadget operations for a single frame
+	 * of a phase.
+	 * @param phase The current phase.
+	 * @param frame The frame within the phase.
+	 */
+	void scriptFrame(Phase phase, s32 frame);
+
+	/**
+	 * Hold the stylus down on a window's depth button.
+	 * @param window The window to press.
+	 */
+	void pressDepthButton(const AmigaWindow* window);
+
+	/**
+	 * Get a checksum of the contents of both displays.
+	 * @return The checksum.
+	 */
+	u32 getDisplayChecksum() const;
+};
+
+#endif
@@ -0,0 +1,6 @@
+#include "benchmark.h"
+
+int main(int argc, char* argv[]) {
+	Benchmark app;
+	return app.main(argc, argv);
+}
@@ -254,9 +254,6 @@ void BitmapDrawing::handleTimer() {
 		default:
 			break;
 	}
-	
-	// Ensure the superbitmap redraws
-	_superBitmap->markRectsDamaged();
 }
 
 void BitmapDrawing::drawLine() {
@@ -59,8 +59,6 @@ void PacMan::run() {
 		_map->drawPills();
 		_player->run();
 		_ghosts->run();
-
-		_superBitmap->markRectsDamaged();
 	}
 }
 
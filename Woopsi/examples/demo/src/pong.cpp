@@ -141,8 +141,6 @@ void Pong::draw() {
 			}
 		}
 	}
-	
-	_superBitmap->markRectsDamaged();
 }
 
 void Pong::handleActionEvent(Gadget& source) {
@@ -167,7 +167,4 @@ void Fire::handleTimer() {
 	u16* tmp = _buffer1;
 	_buffer1 = _buffer2;
 	_buffer2 = tmp;
-	
-	// Redraw the superbitmap to the window
-	_superBitmap->markRectsDamaged();
 }
@@ -26,6 +26,7 @@ public:
 		_flags.decoration = true;
 		_superBitmap = new SuperBitmap(0, 0, 256, 192, 256, 192, 1);
 		_superBitmap->setDraggable(true);
+		_superBitmap->setReceivesDragPath(true);
 		_superBitmap->setGadgetEventHandler(this);
 		_graphics = _superBitmap->getGraphics();
 		addGadget(_superBitmap);
@@ -78,7 +79,6 @@ public:
 				break;
 		}
 
-		_superBitmap->markRectsDamaged();
 		_oldStylusX = point.getX();
 		_oldStylusY = point.getY();
 	};
@@ -97,7 +97,6 @@ public:
 				break;
 		}
 		
-		_superBitmap->markRectsDamaged();
 		_oldStylusX = point.getX();
 		_oldStylusY = point.getY();
 	};
@@ -116,7 +115,6 @@ public:
 				break;
 		}
 
-		_superBitmap->markRectsDamaged();
 		_oldStylusX = x;
 		_oldStylusY = y;
 		
@@ -0,0 +1,31 @@
+#ifndef _NDS_H_
+#define _NDS_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdint.h>
+
+// Headless builds share the SDL build's non-DS code paths, but never open a
+// window or read input from the host.  Frames are rendered into in-memory
+// framebuffers and input is supplied via Hardware::setStylusState() and
+// Hardware::setPadState().
+#define USING_SDL
+#define USING_HEADLESS
+
+#define u16 uint16_t
+#define s16 int16_t
+#define u8 uint8_t
+#define s8 int8_t
+#define u32 uint32_t
+#define s32 int32_t
+#define u64 uint64_t
+#define s64 int64_t
+
+#define SCREEN_WIDTH 256
+#define SCREEN_HEIGHT 192
+
+int fatInitDefault();
+
+#endif
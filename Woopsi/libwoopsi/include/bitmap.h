@@ -3,12 +3,14 @@
 
 #include <nds.h>
 #include "bitmapbase.h"
+#include "dirtyrect.h"
 #include "mutablebitmapbase.h"
 #include "woopsiarray.h"
 
 namespace WoopsiUI {
 
 	class Graphics;
+	class Rect;
 
 	/**
 	 * Class providing bitmap manipulation (drawing, etc) functions.  Creates a
@@ -77,6 +79,8 @@ namespace WoopsiUI {
 
 		/**
 		 * Blit data to the specified co-ordinates using the DMA hardware.
+		 * The data may overlap the destination, so data taken from the
+		 * bitmap itself can be blitted back into it.
 		 * @param x The x co-ordinate to blit to.
 		 * @param y The y co-ordinate to blit to.
 		 * @param data The data to blit.
@@ -93,6 +97,29 @@ namespace WoopsiUI {
 		 */
 		void blitFill(const s16 x, const s16 y, const u16 colour, const u32 size);
 
+		/**
+		 * Fill a rectangular region of the bitmap with a single colour.  The
+		 * region is clipped to the bitmap before it is drawn.
+		 * @param x The x co-ordinate of the region.
+		 * @param y The y co-ordinate of the region.
+		 * @param width The width of the region.
+		 * @param height The height of the region.
+		 * @param colour The colour to fill with.
+		 */
+		void fillRect(s16 x, s16 y, u16 width, u16 height, const u16 colour);
+
+		/**
+		 * XOR every pixel in a rectangular region of the bitmap against the
+		 * specified colour.  The region is clipped to the bitmap before it is
+		 * drawn.
+		 * @param x The x co-ordinate of the region.
+		 * @param y The y co-ordinate of the region.
+		 * @param width The width of the region.
+		 * @param height The height of the region.
+		 * @param colour The colour to XOR against.
+		 */
+		void xorRect(s16 x, s16 y, u16 width, u16 height, const u16 colour);
+
 		/**
 		 * Copies data from the supplied co-ordinates sequentially into dest.
 		 * If the amount to be copied exceeds the available width of the bitmap,
@@ -129,10 +156,51 @@ namespace WoopsiUI {
 		 */
 		void setDimensions(u16 width, u16 height);
 
+		/**
+		 * Check if any pixels have been written to the bitmap since the dirty
+		 * rect was last cleared.
+		 * @return True if the bitmap has been written to.
+		 */
+		inline bool isDirty() const { return _dirtyRect.isDirty(); };
+
+		/**
+		 * Get the bounding rect of all pixels written to the bitmap since the
+		 * dirty rect was last cleared.  The rect is empty if the bitmap is
+		 * not dirty.
+		 * @param rect Reference to a rect to populate with the dirty area.
+		 */
+		inline void getDirtyRect(Rect& rect) const { _dirtyRect.getRect(rect); };
+
+		/**
+		 * Mark the bitmap as clean.  Called once the dirty area has been
+		 * redrawn by whatever is displaying the bitmap.
+		 */
+		inline void clearDirtyRect() { _dirtyRect.clear(_width, _height); };
+
 	protected:
 		u16* _bitmap __attribute__ ((aligned (4)));		/**< Bitmap. */
 		u16 _width;										/**< Width of the bitmap. */
 		u16 _height;									/**< Height of the bitmap. */
+		DirtyRect _dirtyRect;							/**< Area written to since the dirty rect was last cleared. */
+
+		/**
+		 * Grow the dirty area to include the specified region.  The region
+		 * must already be clipped to the bitmap.
+		 * @param x1 The left edge of the region.
+		 * @param y1 The top edge of the region.
+		 * @param x2 The right edge of the region (exclusive).
+		 * @param y2 The bottom edge of the region (exclusive).
+		 */
+		inline void markDirty(s16 x1, s16 y1, s16 x2, s16 y2) { _dirtyRect.mark(x1, y1, x2, y2); };
+
+		/**
+		 * Grow the dirty area to include a run of pixels that may wrap from
+		 * the right-hand edge of one row to the left-hand edge of the next.
+		 * @param x The x co-ordinate of the start of the run.
+		 * @param y The y co-ordinate of the start of the run.
+		 * @param size The number of pixels in the run.
+		 */
+		inline void markDirtyRun(s16 x, s16 y, u32 size) { _dirtyRect.markRun(x, y, size, _width, _height); };
 	};
 }
 
@@ -2,7 +2,7 @@
 #define _DAMAGED_RECT_MANAGER_
 
 #include "rect.h"
-#include "woopsiarray.h"
+#include "region.h"
 
 namespace WoopsiUI {
 
@@ -28,29 +28,63 @@ namespace WoopsiUI {
 		~DamagedRectManager();
 
 		/**
-		 * Add a damaged rect to the list.  The method automatically clips and
-		 * splits the rect to ensure that only new regions are added to the
-		 * list.
+		 * Add a damaged rect to the list.  The rect is merged into the damaged
+		 * region so that each area of the display is only redrawn once.
 		 * @param rect The rect to add to the list.
 		 */
 		void addDamagedRect(const Rect& rect);
+
+		/**
+		 * Add a damaged region to the list.  The region is merged into the
+		 * damaged region so that each area of the display is only redrawn
+		 * once.
+		 * @param region The region to add to the list.
+		 */
+		void addDamagedRegion(const Region& region);
 		
+		/**
+		 * Get the region of the display that is waiting to be redrawn.
+		 * @return The damaged region.
+		 */
+		inline const Region& getDamagedRegion() const { return _damagedRegion; };
+
 		/**
 		 * Redraws all damaged rects.
 		 */
 		void redraw();
 
+		/**
+		 * Get the total number of damaged rects that have been redrawn.  The
+		 * count wraps around on overflow, so measure the difference between
+		 * two readings.
+		 * @return The number of rects redrawn.
+		 */
+		inline u32 getRedrawnRectCount() const { return _redrawnRectCount; };
+
+		/**
+		 * Get the total area of the damaged rects that have been redrawn.
+		 * The count wraps around on overflow, so measure the difference
+		 * between two readings.
+		 * @return The number of pixels redrawn.
+		 */
+		inline u32 getRedrawnPixelCount() const { return _redrawnPixelCount; };
+
 	private:
-		WoopsiArray<Rect>* _damagedRects;		/**< List of damaged rects. */
+		Region _damagedRegion;					/**< Region of the display that needs redrawing. */
 		Gadget* _gadget;						/**< The top-level gadget. */
+		u32 _redrawnRectCount;					/**< Total number of rects redrawn. */
+		u32 _redrawnPixelCount;					/**< Total number of pixels redrawn. */
+		WoopsiArray<Region*> _scratchRegions;	/**< Working regions used by drawRects(), one per level of the gadget tree. */
 		
 		/**
 		 * Redraws all damaged rects.
-		 * @param gadget The gadget to compare with the damaged region list to
-		 * see if it intersects any regions.  If so, those regions are redrawn.
-		 * @param damagedRects Damaged region list.
+		 * @param gadget The gadget to compare with the damaged region to see
+		 * if it intersects it.  If so, the intersecting area is redrawn and
+		 * removed from the region.
+		 * @param damagedRegion Damaged region.
+		 * @param depth Depth of the gadget within the tree being redrawn.
 		 */
-		void drawRects(Gadget* gadget, WoopsiArray<Rect>* damagedRects);
+		void drawRects(Gadget* gadget, Region& damagedRegion, s32 depth);
 	};
 }
 
@@ -0,0 +1,114 @@
+#ifndef _DIRTY_RECT_H_
+#define _DIRTY_RECT_H_
+
+#include <nds.h>
+#include "rect.h"
+
+namespace WoopsiUI {
+
+	/**
+	 * Tracks the bounding rect of all pixels written to a bitmap since the
+	 * rect was last cleared, so that whatever displays the bitmap only needs
+	 * to copy the area that has changed.
+	 */
+	class DirtyRect {
+	public:
+
+		/**
+		 * Constructor.  The rect is created clean.
+		 */
+		inline DirtyRect() {
+			_x1 = 0;
+			_y1 = 0;
+			_x2 = 0;
+			_y2 = 0;
+		};
+
+		/**
+		 * Check if any pixels have been marked since the rect was last
+		 * cleared.
+		 * @return True if any pixels have been marked.
+		 */
+		inline bool isDirty() const { return _x2 > _x1; };
+
+		/**
+		 * Get the bounding rect of all pixels marked since the rect was last
+		 * cleared.  The rect is empty if nothing has been marked.
+		 * @param rect Reference to a rect to populate with the dirty area.
+		 */
+		inline void getRect(Rect& rect) const {
+			if (!isDirty()) {
+				rect.x = 0;
+				rect.y = 0;
+				rect.width = 0;
+				rect.height = 0;
+				return;
+			}
+
+			rect.x = _x1;
+			rect.y = _y1;
+			rect.width = _x2 - _x1;
+			rect.height = _y2 - _y1;
+		};
+
+		/**
+		 * Mark the bitmap as clean.
+		 * @param width The width of the bitmap.
+		 * @param height The height of the bitmap.
+		 */
+		inline void clear(u16 width, u16 height) {
+			_x1 = width;
+			_y1 = height;
+			_x2 = 0;
+			_y2 = 0;
+		};
+
+		/**
+		 * Grow the dirty area to include the specified region.  The region
+		 * must already be clipped to the bitmap.
+		 * @param x1 The left edge of the region.
+		 * @param y1 The top edge of the region.
+		 * @param x2 The right edge of the region (exclusive).
+		 * @param y2 The bottom edge of the region (exclusive).
+		 */
+		inline void mark(s16 x1, s16 y1, s16 x2, s16 y2) {
+			if (x1 < _x1) _x1 = x1;
+			if (y1 < _y1) _y1 = y1;
+			if (x2 > _x2) _x2 = x2;
+			if (y2 > _y2) _y2 = y2;
+		};
+
+		/**
+		 * Grow the dirty area to include a run of pixels that may wrap from
+		 * the right-hand edge of one row to the left-hand edge of the next.
+		 * @param x The x co-ordinate of the start of the run.
+		 * @param y The y co-ordinate of the start of the run.
+		 * @param size The number of pixels in the run.
+		 * @param width The width of the bitmap.
+		 * @param height The height of the bitmap.
+		 */
+		inline void markRun(s16 x, s16 y, u32 size, u16 width, u16 height) {
+			if (size == 0) return;
+
+			if (x + size <= width) {
+				mark(x, y, x + size, y + 1);
+			} else {
+
+				// Run wraps onto following rows, so those rows are dirty
+				// across their full width
+				u32 lastRow = ((y * width) + x + size - 1) / width;
+				if (lastRow >= height) lastRow = height - 1;
+
+				mark(0, y, width, lastRow + 1);
+			}
+		};
+
+	private:
+		s16 _x1;							/**< Left edge of the dirty area. */
+		s16 _y1;							/**< Top edge of the dirty area. */
+		s16 _x2;							/**< Right edge of the dirty area (exclusive). */
+		s16 _y2;							/**< Bottom edge of the dirty area (exclusive). */
+	};
+}
+
+#endif
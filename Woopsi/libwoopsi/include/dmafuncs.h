@@ -26,4 +26,13 @@ void woopsiDmaCopy(const u16* source, u16* dest, u32 count);
  */
 void woopsiDmaFill(u16 fill, u16* dest, u32 count);
 
+/**
+ * Perform a copy between regions of memory that may overlap.  The result is
+ * the same as if the source had first been copied to a temporary buffer.
+ * @param source Pointer to the source.
+ * @param dest Pointer to the destination.
+ * @param count The number of values to copy.
+ */
+void woopsiDmaMove(const u16* source, u16* dest, u32 count);
+
 #endif
@@ -8,9 +8,27 @@
 
 namespace WoopsiUI {
 
+
+	/**
+	 * Number of lines that a lazily-wrapped document wraps at a time.
+	 */
+	const s32 DOCUMENT_LAZY_WRAP_LINES = 32;
+
 	/**
 	 * Contains a WoopsiString and can wrap it to fit within a given width for a
 	 * given font.
+	 *
+	 * Editing the document only rewraps the lines around the edit.  Wrapping
+	 * stops as soon as a line starts at the same point in the unedited text
+	 * as it did before the edit, and the positions of the remaining lines are
+	 * shifted rather than recalculated.
+	 *
+	 * If lazy wrapping is enabled, replacing the text or changing the font or
+	 * width only wraps the first few lines.  The rest of the text is wrapped
+	 * on request by calling wrapLines() or wrapToLine().  Until the whole text
+	 * has been wrapped, getLineCount() returns the number of lines wrapped so
+	 * far and the pixel height of the text is based on an estimate of the
+	 * total number of lines.
 	 */
 	class Document {
 
@@ -123,7 +141,8 @@ namespace WoopsiUI {
 		const s16 getLineTrimmedPixelLength(const s32 lineNumber) const;
 
 		/**
-		 * Get the total height of the text in pixels.
+		 * Get the total height of the text in pixels.  This is based on the
+		 * estimated line count if the text is not fully wrapped.
 		 * @return The total height of the text.
 		 */
 		inline const s32 getPixelHeight() const { return _textPixelHeight; };
@@ -148,11 +167,55 @@ namespace WoopsiUI {
 		inline const u8 getLineHeight() const { return _font->getHeight() + _lineSpacing; };
 
 		/**
-		 * Get the total number of lines in the text.
+		 * Get the total number of lines in the text.  If the document is
+		 * wrapped lazily this is the number of lines that have been wrapped
+		 * so far.
 		 * @return The line count.
 		 */
 		inline const s32 getLineCount() const { return _linePositions.size() - 1; };
 
+		/**
+		 * Get the number of lines that the text is expected to wrap to.  If
+		 * the whole text has been wrapped this is the same as the line count;
+		 * otherwise the number of remaining lines is estimated from the
+		 * average length of the lines wrapped so far.
+		 * @return The estimated line count.
+		 */
+		const s32 getEstimatedLineCount() const;
+
+		/**
+		 * Check if the whole text has been wrapped.
+		 * @return True if the text is fully wrapped.
+		 */
+		inline bool isWrapped() const { return _isWrapped; };
+
+		/**
+		 * Check if the document wraps its text lazily.
+		 * @return True if wrapping is lazy.
+		 */
+		inline bool isLazyWrapping() const { return _isLazy; };
+
+		/**
+		 * Enable or disable lazy wrapping.  Disabling lazy wrapping wraps any
+		 * text that has not yet been wrapped.
+		 * @param isLazy True to wrap the text lazily.
+		 */
+		void setLazyWrapping(const bool isLazy);
+
+		/**
+		 * Wrap more of the text if the document is not yet fully wrapped.
+		 * @param lines The maximum number of lines to wrap.
+		 * @return True if the text is now fully wrapped.
+		 */
+		bool wrapLines(const s32 lines);
+
+		/**
+		 * Ensure that the text has been wrapped as far as the specified
+		 * line, or to the end of the text if it contains fewer lines.
+		 * @param line The line that must be wrapped.
+		 */
+		void wrapToLine(const s32 line);
+
 		/**
 		 * Get a pointer to the Document object's font.
 		 * @return Pointer to the font.
@@ -172,7 +235,8 @@ namespace WoopsiUI {
 
 		/**
 		 * Wrap the text from the line containing the specified char index
-		 * onwards.
+		 * onwards.  This is not necessary after editing the text with the
+		 * document's own methods, which update the wrapping automatically.
 		 * @param charIndex The index of the char to start wrapping from; note
 		 * that the wrapping function will re-wrap that entire line of text.
 		 */
@@ -205,23 +269,65 @@ namespace WoopsiUI {
 		const WoopsiString& getText() const { return _text; };
 
 	private:
-		/**
-		 * Struct defining the position and length of a longest line within the
-		 * _linePositions array.
-		 */
-		typedef struct {
-			s32 index;
-			u8 width;
-		} LongestLine;
-		
 		FontBase* _font;							/**< Font to be used for output */
 		WoopsiArray<s32> _linePositions;			/**< Array containing start indexes of each wrapped line */
-		WoopsiArray<LongestLine> _longestLines;		/**< Array containing data describing successively longer wrapped lines */
+		WoopsiArray<u8> _lineWidths;				/**< Array containing the pixel width of each wrapped line */
 		u8 _lineSpacing;							/**< Spacing between lines of text */
 		s32 _textPixelHeight;						/**< Total height of the wrapped text in pixels */
 		u8 _textPixelWidth;							/**< Total width of the wrapped text in pixels */
 		u16 _width;									/**< Width in pixels available to the text */
 		WoopsiString _text;							/**< Content of the document. */
+		bool _isLazy;								/**< True if the text is wrapped on demand */
+		bool _isWrapped;							/**< True if all of the text has been wrapped */
+
+		/**
+		 * Discard the existing wrapping data and wrap the text again.  If the
+		 * document is wrapped lazily only the first few lines are wrapped.
+		 */
+		void rewrap();
+
+		/**
+		 * Recalculate the height of the text from the number of lines.
+		 */
+		void calculatePixelHeight();
+
+		/**
+		 * Find the start of the line that follows the line starting at the
+		 * specified index.
+		 * @param pos The index of the start of the line.
+		 * @param lineWidth Populated with the pixel width of the line.
+		 * @return The index of the start of the next line, or -1 if the line
+		 * runs to the end of the text.
+		 */
+		s32 wrapLine(s32 pos, s32& lineWidth) const;
+
+		/**
+		 * Rewrap the text from the start of the specified line.  If
+		 * syncIndex is not -1 the existing wrapping data is assumed to
+		 * describe the text before an edit; wrapping stops as soon as a line
+		 * starts at an existing line start at or beyond syncIndex, and the
+		 * existing lines from that point onwards are kept and moved by
+		 * delta.  If the document is wrapped lazily, wrapping also stops once
+		 * it passes the end of the wrapped text or has wrapped
+		 * DOCUMENT_LAZY_WRAP_LINES lines beyond the edit.
+		 * @param line The first line to rewrap.
+		 * @param syncIndex The index in the unedited text after which the
+		 * text is unchanged, or -1 to rewrap to the end of the text.
+		 * @param delta The number of chars added to (or, if negative,
+		 * removed from) the text.
+		 */
+		void wrapFromLine(const s32 line, const s32 syncIndex, const s32 delta);
+
+		/**
+		 * Get the line to start rewrapping from when the text is edited at
+		 * the specified index.  This is the line before the line containing
+		 * the index, as changing the first word of a line can allow it to fit
+		 * on the previous line.  Lines that were split part-way through a
+		 * word are treated as part of the line on which the word starts.
+		 * @param index The index of the edit.
+		 * @return The line to start rewrapping from.
+		 */
+		const s32 getEditLine(const s32 index) const;
 	};
 }
 
@@ -17,11 +17,35 @@ namespace WoopsiUI {
 
 	public:
 
+		/**
+		 * Describes the portion of a string measured by measureRun().
+		 */
+		typedef struct {
+			s32 length;						/**< Number of characters that fit within the width. */
+			s32 width;						/**< Width in pixels of the characters that fit. */
+			s32 breakIndex;					/**< Index of the last breakpoint within the characters that fit, or -1 if there is none. */
+			bool isNewline;					/**< True if the run ends with a newline character. */
+		} TextRun;
+
+		/**
+		 * Constructor.
+		 */
+		inline FontBase() : _widthGeneration(0) { };
+
 		/**
 		 * Destructor.
 		 */
 		virtual inline ~FontBase() { };
 
+		/**
+		 * Get a counter that changes whenever the widths of the font's
+		 * characters change.  Anything that caches measurements made with
+		 * the font can store the counter alongside them and remeasure when
+		 * it differs.
+		 * @return The width generation.
+		 */
+		inline u32 getWidthGeneration() const { return _widthGeneration; };
+
 		/**
 		 * Checks if supplied character is blank in the current font.
 		 * @param letter The character to check.
@@ -84,6 +108,39 @@ namespace WoopsiUI {
 		 */
 		virtual u8 getCharWidth(u32 letter) const = 0;
 
+		/**
+		 * Get a table of the widths of a contiguous range of characters.
+		 * Fonts that can supply a table allow text to be measured without a
+		 * virtual call per character.  The default implementation returns
+		 * NULL, in which case getCharWidth() is used instead.
+		 * @param first Populated with the first character in the table.
+		 * @param count Populated with the number of entries in the table.
+		 * @param defaultWidth Populated with the width of every character
+		 * outside the table.
+		 * @return Pointer to the table, or NULL if the font does not provide
+		 * one.
+		 */
+		virtual const u8* getAdvanceTable(u32& first, u32& count, u8& defaultWidth) const { return NULL; };
+
+		/**
+		 * Measure as much of a portion of a string as fits within the
+		 * specified width, noting where the text could be wrapped.
+		 * Measuring stops after the first newline character.
+		 * @param text The string to measure.
+		 * @param startIndex The index of the first character to measure.
+		 * @param length The maximum number of characters to measure.
+		 * @param maxWidth The width that the characters must fit within.
+		 * @param run Populated with the results of the measurement.
+		 */
+		virtual void measureRun(const WoopsiString& text, s32 startIndex, s32 length, s32 maxWidth, TextRun& run) const;
+
+		/**
+		 * Check if text can be wrapped after the specified character.
+		 * @param letter The character to check.
+		 * @return True if the character is a valid breakpoint.
+		 */
+		static bool isBreakpoint(const u32 letter);
+
 		/**
 		 * Get the height of an individual character.
 		 * @param letter The letter to get the height of.
@@ -103,6 +160,17 @@ namespace WoopsiUI {
 		 * @return The height of the font.
 		 */
 		virtual const u8 getHeight() const = 0;
+
+	protected:
+
+		/**
+		 * Notify anything caching measurements made with the font that the
+		 * widths of its characters have changed.
+		 */
+		inline void invalidateWidths() { ++_widthGeneration; };
+
+	private:
+		u32 _widthGeneration;				/**< Incremented whenever character widths change. */
 	};
 }
 
@@ -18,6 +18,7 @@ namespace WoopsiUI {
 	class GraphicsPort;
 	class FontBase;
 	class RectCache;
+	class Region;
 
 	/**
 	 * Class providing all the basic functionality of a Woopsi gadget.
@@ -46,6 +47,7 @@ namespace WoopsiUI {
 			u8 modal : 1;						/**< True if the gadget is modal. */
 			u8 canReceiveFocus : 1;				/**< True if the gadget can receive focus. */
 			u8 raisesEvents : 1;				/**< True if the gadget raises events to its handler. */
+			u8 receivesDragPath : 1;			/**< True if the gadget is dragged through every stylus sample. */
 		} Flags;
 
 		/**
@@ -94,13 +96,17 @@ namespace WoopsiUI {
 		const s16 getY() const;
 
 		/**
-		 * Get the x co-ordinate of the gadget relative to its parent.
+		 * Get the x co-ordinate of the gadget relative to its parent.  If
+		 * the parent offsets its children (see getChildOffset()) the offset
+		 * is not included.
 		 * @return Parent-space x co-ordinate.
 		 */
 		const s16 getRelativeX() const;
 
 		/**
-		 * Get the y co-ordinate of the gadget relative to its parent.
+		 * Get the y co-ordinate of the gadget relative to its parent.  If
+		 * the parent offsets its children (see getChildOffset()) the offset
+		 * is not included.
 		 * @return Parent-space y co-ordinate.
 		 */
 		const s16 getRelativeY() const;
@@ -255,6 +261,13 @@ namespace WoopsiUI {
 		 */
 		inline const bool raisesEvents() const { return _gadgetEventHandler && _flags.raisesEvents && !_flags.shelved; };
 
+		/**
+		 * Check if this gadget is dragged through every position that the
+		 * stylus passes through between VBLs.
+		 * @return True if the gadget receives the full drag path.
+		 */
+		inline const bool receivesDragPath() const { return _flags.receivesDragPath; };
+
 		/**
 		 * Insert the dimensions that this gadget wants to have into the rect
 		 * passed in as a parameter.  All co-ordinates are relative to the
@@ -271,6 +284,20 @@ namespace WoopsiUI {
 		 */
 		void getClientRect(Rect& rect) const;
 
+		/**
+		 * Get the offset that is added to the co-ordinates of this gadget's
+		 * non-decoration children when converting them to Woopsi-space.
+		 * Gadgets that scroll their children override this so that they can
+		 * move every child by changing a single value instead of moving each
+		 * child in turn.
+		 * @param x Reference to an s16 to populate with the horizontal offset.
+		 * @param y Reference to an s16 to populate with the vertical offset.
+		 */
+		virtual inline void getChildOffset(s16& x, s16& y) const {
+			x = 0;
+			y = 0;
+		};
+
 		/**
 		 * Clips the supplied rect to the boundaries defined by this gadget and
 		 * this gadget's parents.  Co-ordinates are in Woopsi-space.
@@ -282,6 +309,12 @@ namespace WoopsiUI {
 		 * Gets a pointer to a new instance of the GraphicsPort class to allow
 		 * drawing within this gadget's client space.
 		 * The GraphicsPort object must be deleted when it is no longer required.
+		 *
+		 * The port clips to this gadget's cached visible region rather than
+		 * to a copy of it.  Delete the port before the gadget or any gadget
+		 * that overlaps it moves, resizes, is shown, hidden, raised or
+		 * lowered, as any of these changes the region that the port clips
+		 * to.
  		 * @param isForeground True to use the foreground clipping list (draw
 		 * over all space, including that overlapped by children) or background
 		 * clipping list (not including that overlapped by children).
@@ -309,7 +342,7 @@ namespace WoopsiUI {
 		 * gadget, including any covered by children.
 		 * @return A pointer to a vector of all visible regions.
 		 */
-		WoopsiArray<Rect>* getForegroundRegions();
+		Region* getForegroundRegions();
 
 		/**
 		 * Gets a pointer to the gadget's font.
@@ -423,6 +456,17 @@ namespace WoopsiUI {
 		 */
 		inline void setRaisesEvents(const bool raisesEvents) { _flags.raisesEvents = raisesEvents; };
 
+		/**
+		 * Sets whether or not the gadget is dragged through every position
+		 * that the stylus passes through between VBLs.  By default a gadget
+		 * receives a single drag per VBL to the stylus' latest position.
+		 * Gadgets that draw along the stylus path should enable this so that
+		 * fast strokes are not reduced to straight lines between VBLs.
+		 * @param receivesDragPath True to receive one drag per stylus
+		 * sample.
+		 */
+		inline void setReceivesDragPath(const bool receivesDragPath) { _flags.receivesDragPath = receivesDragPath; };
+
 		/**
 		 * Sets the background colour.
 		 * @param colour The new background colour.
@@ -488,13 +532,14 @@ namespace WoopsiUI {
 		virtual void setGlyphFont(FontBase* font);
 
 		/**
-		 * Redraws the region of the gadget represented by rect.  Rect should
-		 * be supplied in Woopsi-space co-ordinates and should be pre-clipped
-		 * to the visible regions of the gadget.  This function should only
-		 * ever be called by the DisplayController.
-		 * @param rect The rect to draw.
+		 * Redraws the area of the gadget represented by region.  The region
+		 * should be supplied in Woopsi-space co-ordinates and should be
+		 * pre-clipped to the visible regions of the gadget.  The border and
+		 * contents are each drawn once for the whole region.  This function
+		 * should only ever be called by the DamagedRectManager.
+		 * @param region The region to draw.
 		 */
-		void redraw(const Rect& rect);
+		void redraw(const Region& region);
 
 		/**
 		 * Enables the gadget.
@@ -837,7 +882,10 @@ namespace WoopsiUI {
 		 * be called in user code.
 		 * @param parent A pointer to the parent gadget.
 		 */
-		inline void setParent(Gadget* parent) { _parent = parent; };
+		inline void setParent(Gadget* parent) {
+			_parent = parent;
+			invalidateScreenRectCache();
+		};
 
 		/**
 		 * Rebuild the list of this gadget's visible regions.  If the cache is
@@ -1053,6 +1101,12 @@ namespace WoopsiUI {
 		// Visible regions
 		RectCache* _rectCache;					/**< List of the gadget's visible regions. */
 
+		// Woopsi-space co-ordinate cache
+		mutable s16 _screenX;					/**< Cached Woopsi-space x co-ordinate. */
+		mutable s16 _screenY;					/**< Cached Woopsi-space y co-ordinate. */
+		mutable Rect _hierarchyClipRect;		/**< Cached Woopsi-space area of the ancestors that the gadget can draw within. */
+		mutable bool _isScreenRectCacheValid;	/**< True if the cached co-ordinates are up to date. */
+
 		GadgetBorderSize _borderSize;			/**< Size of the gadget borders. */
 
 		// Context menu item definitions
@@ -1065,12 +1119,72 @@ namespace WoopsiUI {
 
 		FrameBuffer* getFrameBufferForScreenNumber(u8 screenNumber) const;
 
+		/**
+		 * Mark the cached Woopsi-space co-ordinates and hierarchy clipping
+		 * rect of this gadget and all of its descendants as invalid.  Must be
+		 * called whenever the gadget moves, resizes, changes its borders or
+		 * changes parent.
+		 */
+		void invalidateScreenRectCache();
+
+		/**
+		 * Recalculate the cached Woopsi-space co-ordinates and hierarchy
+		 * clipping rect if they are invalid.
+		 */
+		void cacheScreenRect() const;
+
+		/**
+		 * Convert Woopsi-space co-ordinates to the co-ordinate space that
+		 * this gadget's parent uses for its children, which is the space
+		 * that moveTo() expects.  Unlike Woopsi-space, this excludes the
+		 * parent's child offset (see getChildOffset()) unless this gadget is
+		 * a decoration.
+		 * @param x Pointer to the x co-ordinate to convert.
+		 * @param y Pointer to the y co-ordinate to convert.
+		 */
+		void convertWoopsiSpaceToParentSpace(s16* x, s16* y) const;
+
+		/**
+		 * Convert co-ordinates in the space that this gadget's parent uses
+		 * for its children to Woopsi-space.  The reverse of
+		 * convertWoopsiSpaceToParentSpace().
+		 * @param x Pointer to the x co-ordinate to convert.
+		 * @param y Pointer to the y co-ordinate to convert.
+		 */
+		void convertParentSpaceToWoopsiSpace(s16* x, s16* y) const;
+
+		/**
+		 * Called after the gadget has moved.  Copies the parts of the gadget
+		 * that were visible at its old position and are still visible at its
+		 * new position to their new location on the display, and marks the
+		 * rest of the old and new positions as damaged.  Moving a gadget
+		 * therefore costs a copy rather than a redraw of the gadget and all
+		 * of its children.
+		 * @param oldRegion The visible region of the gadget before it moved.
+		 * @param dx The horizontal distance moved.
+		 * @param dy The vertical distance moved.
+		 */
+		void moveVisibleRegion(const Region& oldRegion, s16 dx, s16 dy);
+
 		/**
 		 * Draw the area of this gadget that falls within the clipping region.
 		 * @param port The GraphicsPort to draw to.
 		 */
 		virtual inline void drawContents(GraphicsPort* port) { };
 
+		/**
+		 * Draw the area of this gadget that falls within the supplied
+		 * region.  The default implementation calls drawContents(port) once
+		 * for each rect in the region, as gadgets may only draw the area
+		 * within the port's first clip rect.  Gadgets that can draw the
+		 * whole region at once should override this method.
+		 * @param port The GraphicsPort to draw to.  Its clipping region
+		 * matches the supplied region.
+		 * @param region The region to draw, in Woopsi-space co-ordinates.
+		 * It may extend beyond the edges of the port.
+		 */
+		virtual void drawContents(GraphicsPort* port, const Region& region);
+
 		/**
 		 * Draw the area of this gadget that falls within the clipping region.
 		 * @param port The GraphicsPort to draw to.
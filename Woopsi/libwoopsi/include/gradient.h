@@ -37,7 +37,7 @@ namespace WoopsiUI {
 		s16 _deltaR;				/**< Value that red component is incremented at each new gradient step */
 		s16 _deltaG;				/**< Value that green component is incremented at each new gradient step */
 		s16 _deltaB;				/**< Value that blue component is incremented at each new gradient step */
-		s16* _rowColour;			/**< Array of precalculated gradient colours for each step */
+		u16* _rowColour;			/**< Array of precalculated gradient colours for each step */
 
 		/**
 		 * Draw the area of this gadget that falls within the clipping region.
@@ -47,6 +47,14 @@ namespace WoopsiUI {
 		 */
 		virtual void drawContents(GraphicsPort* port);
 
+		/**
+		 * Draw the area of this gadget that falls within the supplied
+		 * region.  The gradient is drawn over the whole region at once.
+		 * @param port The GraphicsPort to draw to.
+		 * @param region The region to draw.
+		 */
+		virtual inline void drawContents(GraphicsPort* port, const Region& region) { drawContents(port); };
+
 		/**
 		 * Resize the gadget and recalculate the gradient.
 		 * @param width The new gadget width.
@@ -67,7 +75,7 @@ namespace WoopsiUI {
 		/**
 		 * Destructor.
 		 */
-		virtual inline ~Gradient() { };
+		virtual inline ~Gradient() { delete[] _rowColour; };
 
 		/**
 		 * Copy constructor is protected to prevent usage.
@@ -81,6 +81,18 @@ namespace WoopsiUI {
 		 * @param colour The colour of the rectangle.
 		 */
 		virtual void drawFilledRect(s16 x, s16 y, u16 width, u16 height, u16 colour);
+
+		/**
+		 * Draw a filled rectangle to the internal bitmap in which each row
+		 * has its own colour.  Each visible pixel is written once.
+		 * @param x The x co-ordinate of the rectangle.
+		 * @param y The y co-ordinate of the rectangle.
+		 * @param width The width of the rectangle.
+		 * @param height The height of the rectangle.
+		 * @param rowColours Array containing the colour of each row of the
+		 * rectangle.  Must contain at least height entries.
+		 */
+		virtual void drawFilledRows(s16 x, s16 y, u16 width, u16 height, const u16* rowColours);
 		
 		/**
 		 * Draw an unfilled rectangle to the internal bitmap.
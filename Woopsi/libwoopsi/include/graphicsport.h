@@ -5,6 +5,7 @@
 #include "gadget.h"
 #include "woopsiarray.h"
 #include "graphics.h"
+#include "region.h"
 
 namespace WoopsiUI {
 	
@@ -81,19 +82,19 @@ namespace WoopsiUI {
 		 * can draw.
 		 * @param isEnabled Set this to false to disable all drawing commands.
 		 * @param bitmap The bitmap that the port will draw to. 
-		 * @param clipRectList An array of clipping regions within which the
-		 * class must draw.  If set, clipRect must be NULL.
-		 * @param clipRect The clipping region within which the class must draw.
-		 * If set, clipRectList must be NULL.
-		 */
-		GraphicsPort(const s16 x, const s16 y, const u16 width, const u16 height, const bool isEnabled, FrameBuffer* bitmap, const WoopsiArray<Rect>* clipRectList, const Rect* clipRect);
+		 * @param clipRegion The clipping region within which the class must
+		 * draw.  If set, clipRect must be NULL.  The port refers to the
+		 * region rather than copying it, so the region must not be changed
+		 * or deleted while the port is in use.
+		 * @param clipRect The clipping rect within which the class must draw.
+		 * If set, clipRegion must be NULL.
+		 */
+		GraphicsPort(const s16 x, const s16 y, const u16 width, const u16 height, const bool isEnabled, FrameBuffer* bitmap, const Region* clipRegion, const Rect* clipRect);
 		
 		/**
 		 * Destructor.
 		 */
-		virtual inline ~GraphicsPort() {
-			delete _graphics;
-		};
+		virtual inline ~GraphicsPort() { };
 
 		/**
 		 * Sets the clip rect.  Attempts to draw outside of this region
@@ -115,6 +116,24 @@ namespace WoopsiUI {
 		 */
 		void getClipRect(Rect& rect) const;
 
+		/**
+		 * Get the complete clipping region.  As with getClipRect(), the
+		 * region is converted to GraphicsPort-space.
+		 * @param region A region that will be populated with the current
+		 * clipping region.
+		 */
+		void getClipRegion(Region& region) const;
+
+		/**
+		 * Get the smallest rect that contains the entire clipping region.
+		 * As with getClipRect(), the rect is converted to GraphicsPort-space.
+		 * Unlike getClipRegion(), this does not copy the region.
+		 * @param rect A rect that will be populated with the bounds of the
+		 * clipping region.  It has no dimensions if the port cannot draw
+		 * anywhere.
+		 */
+		void getClipBounds(Rect& rect) const;
+
 		/**
 		 * Return the x co-ordinate of the graphics port.
 		 * @return The x co-ordinate of the graphics port.
@@ -126,6 +145,18 @@ namespace WoopsiUI {
 		 * @return The y co-ordinate of the graphics port.
 		 */
 		const s16 getY() const { return _rect.y; };
+
+		/**
+		 * Return the width of the graphics port.
+		 * @return The width of the graphics port.
+		 */
+		inline const s32 getWidth() const { return _rect.width; };
+
+		/**
+		 * Return the height of the graphics port.
+		 * @return The height of the graphics port.
+		 */
+		inline const s32 getHeight() const { return _rect.height; };
 		
 		/**
 		 * Draw a pixel to the bitmap.
@@ -144,6 +175,18 @@ namespace WoopsiUI {
 		 * @param colour The colour of the rectangle.
 		 */
 		void drawFilledRect(s16 x, s16 y, u16 width, u16 height, u16 colour);
+
+		/**
+		 * Draw a filled rectangle to the bitmap in which each row has its
+		 * own colour.  Each visible pixel is written once.
+		 * @param x The x co-ordinate of the rectangle.
+		 * @param y The y co-ordinate of the rectangle.
+		 * @param width The width of the rectangle.
+		 * @param height The height of the rectangle.
+		 * @param rowColours Array containing the colour of each row of the
+		 * rectangle.  Must contain at least height entries.
+		 */
+		void drawFilledRows(s16 x, s16 y, u16 width, u16 height, const u16* rowColours);
 		
 		/**
 		 * Draw an unfilled rectangle to the bitmap
@@ -281,6 +324,22 @@ namespace WoopsiUI {
 		 */
 		void drawText(s16 x, s16 y, FontBase* font, const WoopsiString& string, s32 startIndex, s32 length, u16 colour = 0);
 
+		/**
+		 * Draw a particular length of a string whose width is already known
+		 * to the bitmap in a specific colour.  Avoids measuring the string
+		 * again when the caller has cached its width.
+		 * @param x The x co-ordinate of the string.
+		 * @param y The y co-ordinate of the string.
+		 * @param font The font to draw with.
+		 * @param string The string to output.
+		 * @param startIndex The start index within the string from which
+		 * drawing will commence.
+		 * @param length The number of characters to draw.
+		 * @param colour The colour of the string.
+		 * @param width The width of the characters to draw in pixels.
+		 */
+		void drawText(s16 x, s16 y, FontBase* font, const WoopsiString& string, s32 startIndex, s32 length, u16 colour, u16 width);
+
 		/**
 		 * Draw a portion of a string on a baseline (chars may have different
 		 * tops/heights/depths) to the bitmap.
@@ -427,14 +486,46 @@ namespace WoopsiUI {
 		virtual void drawFilledEllipse(s16 xCentre, s16 yCentre, s16 horizRadius, s16 vertRadius, u16 colour);
 
 	private:
-		WoopsiArray<Rect> _clipRectList;		/**< List of rects that the port must draw within. */
+		const Region* _clipRegion;				/**< Region that the port must draw within, or NULL to use _clipRect.  Not owned by the port. */
+		Rect _clipRect;							/**< Rect that the port must draw within if there is no clip region. */
 		Rect _rect;								/**< Total area that the port can draw within. */
 		bool _isEnabled;						/**< If false, nothing will be drawn. */
-		Graphics* _graphics;					/**< Used to draw to the bitmap. */
+		FrameBuffer* _bitmap;					/**< Bitmap that the port draws to. */
+		Graphics _graphics;						/**< Used to draw to the bitmap. */
 		bool _isTopScreen;						/**< True if drawing to the top screen. */
 		
 		void convertPortToScreenSpace(s16* x, s16* y);
-		void addClipRect(const Rect& clipRect);
+
+		/**
+		 * Get the number of rects in the clipping region.  Some of them may
+		 * fall outside the port.
+		 * @return The number of clip rects.
+		 */
+		inline s32 getClipRectCount() const { return _clipRegion != NULL ? _clipRegion->size() : 1; };
+
+		/**
+		 * Get a rect from the clipping region, clipped to the dimensions of
+		 * the port.
+		 * @param index The index of the rect.
+		 * @param rect Populated with the clipped rect, in Woopsi-space
+		 * co-ordinates.
+		 * @return True if the clipped rect has dimensions.
+		 */
+		bool getClipRectAt(s32 index, Rect& rect) const;
+
+		/**
+		 * Find the next rect in the clip region that overlaps the specified
+		 * area.  Searching stops at the first band of the region that lies
+		 * entirely below the area.
+		 * @param index The index of the clip rect to start searching from.
+		 * Updated to the index of the rect found.
+		 * @param bounds The area to be drawn, in framebuffer co-ordinates.
+		 * If NULL, every clip rect is returned.
+		 * @param rect Populated with the clip rect found, in framebuffer
+		 * co-ordinates.
+		 * @return True if a rect was found; false if not.
+		 */
+		bool getNextClipRect(s32& index, const Rect* bounds, Rect& rect) const;
 	};
 }
 
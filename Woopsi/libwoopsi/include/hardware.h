@@ -79,6 +79,49 @@ namespace WoopsiUI {
 		 */
 		static inline FrameBuffer* getBottomBuffer() { return _bottomBuffer; };
 
+#if defined(USING_SDL) && !defined(USING_HEADLESS)
+
+		/**
+		 * Choose how waitForVBlank() paces frames in which nothing was drawn.
+		 * By default idle frames sleep for the remainder of the frame.  If
+		 * waiting for input is enabled, idle frames instead block until SDL
+		 * reports an event, so an idle GUI uses no CPU.  Timers and key
+		 * repeats do not advance while blocked.
+		 * @param waitForInput True to block until input arrives on idle
+		 * frames.
+		 */
+		static inline void setWaitForInput(bool waitForInput) {
+			_waitForInput = waitForInput;
+		};
+
+#endif
+
+#ifdef USING_HEADLESS
+
+		/**
+		 * Set the stylus state that will be read at the end of the next VBL.
+		 * Only available in headless builds, which have no input hardware.
+		 * @param x The x co-ordinate of the stylus on the bottom screen.
+		 * @param y The y co-ordinate of the stylus on the bottom screen.
+		 * @param isHeld True if the stylus is held down.
+		 */
+		static inline void setStylusState(s16 x, s16 y, bool isHeld) {
+			_stylus.setHeadlessState(x, y, isHeld);
+		};
+
+		/**
+		 * Set the buttons that will be read as held at the end of the next
+		 * VBL.  Only available in headless builds, which have no input
+		 * hardware.
+		 * @param keys Bitmask of held buttons.  Each button is represented by
+		 * the bit (1 << keyCode), where keyCode is a Pad::KeyCode value.
+		 */
+		static inline void setPadState(u32 keys) {
+			_pad.setHeadlessState(keys);
+		};
+
+#endif
+
 	private:
 		static Pad _pad;						/**< State of the DS' pad. */
 		static Stylus _stylus;					/**< State of the DS' stylus. */
@@ -89,9 +132,30 @@ namespace WoopsiUI {
 
 #ifdef USING_SDL
 
+#ifndef USING_HEADLESS
 		static SDL_Window* _window;
 		static SDL_Renderer* _renderer;
 		static SDL_Texture* _texture;
+		static Uint32 _lastFrameTime;			/**< Tick count at the end of the last frame. */
+		static bool _waitForInput;				/**< Block on idle frames until input arrives. */
+		static bool _needsPresent;				/**< Window must be redrawn even if nothing changed. */
+
+		/**
+		 * Copy the dirty area of a frame buffer into the display texture and
+		 * mark the frame buffer as clean.
+		 * @param buffer The frame buffer to upload.
+		 * @param y The y co-ordinate of the buffer within the texture.
+		 * @return True if anything was uploaded.
+		 */
+		static bool uploadDirtyRect(FrameBuffer* buffer, s16 y);
+
+		/**
+		 * Handle a single SDL event.
+		 * @param event The event to handle.
+		 */
+		static void handleEvent(const SDL_Event& event);
+#endif
+
 		static u16* _topBitmap;
 		static u16* _bottomBitmap;
 
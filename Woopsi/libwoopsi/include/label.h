@@ -111,6 +111,9 @@ namespace WoopsiUI {
 		s32 _textY;								/**< Y co-ordinate of the text relative to the gadget. */
 		TextAlignmentHoriz _hAlignment;			/**< Horizontal alignment of the text. */
 		TextAlignmentVert _vAlignment;			/**< Vertical alignment of the text. */
+		mutable u16 _textWidth;					/**< Cached width of the text in pixels. */
+		mutable const FontBase* _textWidthFont;	/**< Font that _textWidth was measured with, or NULL if the text has changed. */
+		mutable u32 _textWidthGeneration;		/**< Width generation of the font when _textWidth was measured. */
 
 		/**
 		 * Draw the area of this gadget that falls within the clipping region.
@@ -158,6 +161,38 @@ namespace WoopsiUI {
 		 */
 		virtual void markTextRectDamaged();
 
+		/**
+		 * Get the width of the text in pixels.  The width is measured once
+		 * and cached until the text, the font or the font's character widths
+		 * change, so redrawing and realigning unchanged text does not measure
+		 * it again.
+		 * @return The width of the text in pixels.
+		 */
+		const u16 getTextWidth() const;
+
+		/**
+		 * Check if the cached text width was measured with the current font
+		 * and character widths.
+		 * @return True if the cached width is up to date.
+		 */
+		inline bool isTextWidthValid() const {
+			return (_textWidthFont == getFont()) && (_textWidthGeneration == getFont()->getWidthGeneration());
+		};
+
+		/**
+		 * Realign the text if the font's character widths have changed since
+		 * it was positioned.  Called before drawing the text.
+		 */
+		inline void validateTextPosition() {
+			if (!isTextWidthValid()) calculateTextPositionHorizontal();
+		};
+
+		/**
+		 * Discard the cached text width.  Must be called whenever the text
+		 * is changed.
+		 */
+		inline void invalidateTextWidth() { _textWidthFont = NULL; };
+
 		/**
 		 * Destructor.
 		 */
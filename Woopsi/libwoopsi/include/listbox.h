@@ -151,6 +151,19 @@ namespace WoopsiUI {
 		 */
 		virtual void sort();
 
+		/**
+		 * Start a batch of changes to the options.  The listbox is not
+		 * resized or redrawn until the matching call to endUpdate(), so
+		 * adding large numbers of options takes linear rather than
+		 * quadratic time.  See ListData::beginUpdate().
+		 */
+		inline void beginUpdate() { _options.beginUpdate(); };
+
+		/**
+		 * End a batch of changes started with beginUpdate().
+		 */
+		inline void endUpdate() { _options.endUpdate(); };
+
 		/**
 		 * Get the total number of options.
 		 * @return The number of options.
@@ -210,12 +223,22 @@ namespace WoopsiUI {
 
 		/**
 		 * Draw the area of this gadget that falls within the clipping region.
-		 * Called by the redraw() function to draw all visible regions.
+		 * Called by the redraw() function to draw all visible regions.  Only
+		 * the options that overlap the bounds of the clipping region are
+		 * drawn.
 		 * @param port The GraphicsPort to draw to.
 		 * @see redraw()
 		 */
 		virtual void drawContents(GraphicsPort* port);
 
+		/**
+		 * Draw the options that fall within the supplied region.  The port
+		 * is already clipped to the region, so all of it is drawn at once.
+		 * @param port The GraphicsPort to draw to.
+		 * @param region The region to draw.
+		 */
+		virtual inline void drawContents(GraphicsPort* port, const Region& region) { drawContents(port); };
+
 		/**
 		 * Draw the area of this gadget that falls within the clipping region.
 		 * Called by the redraw() function to draw all visible regions.
@@ -40,6 +40,29 @@ namespace WoopsiUI {
 		 */
 		virtual void addItem(ListDataItem* item);
 
+		/**
+		 * Start a batch of changes.  Data changed and selection changed events
+		 * are not raised until the matching call to endUpdate(), and items
+		 * added while the list sorts inserted items are appended and sorted
+		 * in a single pass when the batch ends.  The order of the items is
+		 * therefore undefined until endUpdate() is called.  Calls can be
+		 * nested.
+		 */
+		virtual void beginUpdate();
+
+		/**
+		 * End a batch of changes started with beginUpdate().  When the
+		 * outermost batch ends, any pending sort is performed and a single
+		 * data changed and/or selection changed event is raised.
+		 */
+		virtual void endUpdate();
+
+		/**
+		 * Check if a batch of changes is in progress.
+		 * @return True if beginUpdate() has been called more times than
+		 * endUpdate().
+		 */
+		inline const bool isUpdating() const { return _updateDepth > 0; };
 
 		/**
 		 * Remove an item by its index.
@@ -157,13 +180,17 @@ namespace WoopsiUI {
 		ListDataEventHandler* _listDataEventHandler;				/**< Event handler. */
 		bool _allowMultipleSelections;								/**< If true, multiple options can be selected. */
 		bool _sortInsertedItems;									/**< Automatically sorts items on insertion if true. */
+		s32 _updateDepth;											/**< Number of unfinished beginUpdate() calls. */
+		bool _isSortPending;										/**< True if items were appended to a sorted list during an update. */
+		bool _isDataChangedPending;									/**< True if a data changed event was held back during an update. */
+		bool _isSelectionChangedPending;							/**< True if a selection changed event was held back during an update. */
 
 		/**
-		 * Quick sort the items using their compareTo() methods.
-		 * @param start The index to start sorting at.
-		 * @param end The index to stop sorting at.
+		 * Merge sort the items using their compareTo() methods.  The sort is
+		 * stable, does not recurse, and takes linear time if the items are
+		 * already sorted.
 		 */
-		virtual void quickSort(const s32 start, const s32 end);
+		virtual void mergeSort();
 
 		/**
 		 * Swap the locations of two items in the array.
@@ -174,19 +201,22 @@ namespace WoopsiUI {
 
 		/**
 		 * Return the index that an item should be inserted at to maintain a
-		 * sorted list of data.
+		 * sorted list of data.  Uses a binary search; the item is placed
+		 * before any items that it compares equal to.
 		 * @param item The item to insert.
 		 * @return The index that the item should be imserted into at.
 		 */
 		const s32 getSortedInsertionIndex(const ListDataItem* item) const;
 
 		/**
-		 * Raise a data changed event.
+		 * Raise a data changed event, or record that one is due if a batch of
+		 * changes is in progress.
 		 */
 		void raiseDataChangedEvent();
 
 		/**
-		 * Raise a selection changed event.
+		 * Raise a selection changed event, or record that one is due if a
+		 * batch of changes is in progress.
 		 */
 		void raiseSelectionChangedEvent();
 	};
@@ -6,6 +6,8 @@
 
 namespace WoopsiUI {
 
+	class FontBase;
+
 	/**
 	 * Class representing a data item within a list.  Intended for use within
 	 * the ListData class.
@@ -31,6 +33,16 @@ namespace WoopsiUI {
 		 */
 		inline const WoopsiString& getText() const { return _text; };
 
+		/**
+		 * Get the width of the item's text in the specified font.  The text
+		 * cannot change, so the width is measured once and cached until a
+		 * different font is requested or the font's character widths
+		 * change.
+		 * @param font The font to measure with.
+		 * @return The width of the text in pixels.
+		 */
+		const u16 getTextWidth(const FontBase* font) const;
+
 		/**
 		 * Get the item's value.
 		 * @return The item's value.
@@ -65,6 +77,9 @@ namespace WoopsiUI {
 		WoopsiString _text;				/**< Text to display for option. */
 		u32 _value;						/**< Option value. */
 		bool _isSelected;				/**< True if the option is selected. */
+		mutable u16 _textWidth;			/**< Cached width of the text in pixels. */
+		mutable const FontBase* _textWidthFont;	/**< Font that _textWidth was measured with. */
+		mutable u32 _textWidthGeneration;	/**< Width generation of the font when _textWidth was measured. */
 	};
 }
 
@@ -7,6 +7,7 @@
 #include "woopsistring.h"
 #include "document.h"
 #include "keyboardeventhandler.h"
+#include "gadgeteventhandler.h"
 #include "textboxbase.h"
 
 namespace WoopsiUI {
@@ -20,8 +21,15 @@ namespace WoopsiUI {
 	 * it contains can be changed or added to.  It can remember more
 	 * rows of text than it can display, and these additional
 	 * rows can be scrolled through.
+	 *
+	 * A textbox that tracks all rows wraps its text lazily.  Only the rows
+	 * that are visible, and the page below them, are wrapped when the text
+	 * is drawn; the rest of the text is wrapped a few rows at a time each
+	 * frame.  Text that cannot be wrapped immediately is shown from the top
+	 * rather than the bottom.  The textbox raises an action event whenever
+	 * the height of its canvas changes as the text is wrapped.
 	 */
-	class MultiLineTextBox : public TextBoxBase, public ScrollingPanel, public KeyboardEventHandler  {
+	class MultiLineTextBox : public TextBoxBase, public ScrollingPanel, public KeyboardEventHandler, public GadgetEventHandler  {
 	public:
 
 		/**
@@ -54,7 +62,7 @@ namespace WoopsiUI {
 		 * forgotten; text is essentially stored as a queue, and adding to the back
 		 * of a full queue causes the front items to be popped off.  Setting this to
 		 * 0 will make the textbox track only the visible rows.  Setting this to -1
-		 * will make the textbox track all rows.
+		 * will make the textbox track all rows and wrap its text lazily.
 		 * @param style The style that the gadget should use.  If this is not
 		 * specified, the gadget will use the values stored in the global
 		 * defaultGadgetStyle object.  The gadget will copy the properties of
@@ -189,6 +197,13 @@ namespace WoopsiUI {
 		 */
 		virtual void handleKeyboardRepeatEvent(WoopsiKeyboard& source, const WoopsiKey& key);
 
+		/**
+		 * Handles events raised by the timer that wraps the text in the
+		 * background.
+		 * @param source The gadget that raised the event.
+		 */
+		virtual void handleActionEvent(Gadget& source);
+
 		/**
 		 * Check if the textbox opens the keyboard popup when double-clicked.
 		 * @return True if the keyboard pops up; false if not.
@@ -215,6 +230,7 @@ namespace WoopsiUI {
 		s32 _cursorPos;					/**< Position of the cursor within the string. */
 		bool _showCursor;				/**< Set to true to make cursor visible. */
 		bool _opensKeyboard;			/**< Set to false to disable keyboard popup when double-clicked. */
+		WoopsiTimer* _wrapTimer;		/**< Wraps the rest of a lazily-wrapped document in the background; NULL if wrapping is not lazy. */
 
 		/**
 		 * Get the co-ordinates of the cursor relative to the text.
@@ -249,12 +265,22 @@ namespace WoopsiUI {
 
 		/**
 		 * Draw the area of this gadget that falls within the clipping region.
-		 * Called by the redraw() function to draw all visible regions.
+		 * Called by the redraw() function to draw all visible regions.  Only
+		 * the rows of text that overlap the bounds of the clipping region are
+		 * drawn.
 		 * @param port The GraphicsPort to draw to.
 		 * @see redraw()
 		 */
 		virtual void drawContents(GraphicsPort* port);
 
+		/**
+		 * Draw the rows of text that fall within the supplied region.  The port
+		 * is already clipped to the region, so all of it is drawn at once.
+		 * @param port The GraphicsPort to draw to.
+		 * @param region The region to draw.
+		 */
+		virtual inline void drawContents(GraphicsPort* port, const Region& region) { drawContents(port); };
+
 		/**
 		 * Draw the area of this gadget that falls within the clipping region.
 		 * Called by the redraw() function to draw all visible regions.
@@ -313,6 +339,13 @@ namespace WoopsiUI {
 		 */
 		void jumpToTextBottom();
 
+		/**
+		 * Starts wrapping the rest of the text in the background if the
+		 * document has not been fully wrapped.  Does nothing unless the
+		 * document is wrapped lazily.
+		 */
+		void wrapInBackground();
+
 		/**
 		 * Resize the textbox to the new dimensions.
 		 * @param width The new width.
@@ -387,10 +420,11 @@ namespace WoopsiUI {
 		void calculateVisibleRows();
 
 		/**
-		 * Draws text.
+		 * Draws the rows of text that overlap the supplied rect.
 		 * @param port The GraphicsPort to draw to.
+		 * @param rect The area to draw, in GraphicsPort-space co-ordinates.
 		 */
-		void drawText(GraphicsPort* port);
+		void drawText(GraphicsPort* port, const Rect& rect);
 
 		/**
 		 * Draws the cursor.
@@ -6,6 +6,8 @@
 
 namespace WoopsiUI {
 
+	class Rect;
+
 	/**
 	 * Abstract class defining the basic properties of an editable bitmap.
 	 */
@@ -27,6 +29,8 @@ namespace WoopsiUI {
 
 		/**
 		 * Blit data to the specified co-ordinates using the DMA hardware.
+		 * The data may overlap the destination, so data taken from the
+		 * bitmap itself can be blitted back into it.
 		 * @param x The x co-ordinate to blit to.
 		 * @param y The y co-ordinate to blit to.
 		 * @param data The data to blit.
@@ -42,6 +46,69 @@ namespace WoopsiUI {
 		 * @param size The number of u16s to blit.
 		 */
 		virtual void blitFill(const s16 x, const s16 y, const u16 colour, const u32 size) = 0;
+
+		/**
+		 * Fill a rectangular region of the bitmap with a single colour.  The
+		 * region is clipped to the bitmap once before drawing begins, and each
+		 * row is then filled directly through a pointer into the bitmap data.
+		 * @param x The x co-ordinate of the region.
+		 * @param y The y co-ordinate of the region.
+		 * @param width The width of the region.
+		 * @param height The height of the region.
+		 * @param colour The colour to fill with.
+		 */
+		virtual void fillRect(s16 x, s16 y, u16 width, u16 height, const u16 colour) = 0;
+
+		/**
+		 * XOR every pixel in a rectangular region of the bitmap against the
+		 * specified colour.  The top bit of each resultant pixel is always
+		 * set.  The region is clipped to the bitmap before drawing begins.
+		 * @param x The x co-ordinate of the region.
+		 * @param y The y co-ordinate of the region.
+		 * @param width The width of the region.
+		 * @param height The height of the region.
+		 * @param colour The colour to XOR against.
+		 */
+		virtual void xorRect(s16 x, s16 y, u16 width, u16 height, const u16 colour) = 0;
+
+	protected:
+
+		/**
+		 * Clip a rectangular region to the dimensions of a bitmap.
+		 * @param bitmapWidth The width of the bitmap.
+		 * @param bitmapHeight The height of the bitmap.
+		 * @param x The x co-ordinate of the region.
+		 * @param y The y co-ordinate of the region.
+		 * @param width The width of the region.
+		 * @param height The height of the region.
+		 * @param rect Populated with the clipped region.
+		 * @return True if any of the region falls within the bitmap.
+		 */
+		static bool clipToBitmap(u16 bitmapWidth, u16 bitmapHeight, s16 x, s16 y, u16 width, u16 height, Rect& rect);
+
+		/**
+		 * Fill a rectangular region of bitmap data with a single colour.
+		 * Used by subclasses that store their pixels as a single array of
+		 * rows.
+		 * @param data Pointer to the first pixel of the bitmap.
+		 * @param bitmapWidth The width of the bitmap.
+		 * @param rect The region to fill.  Must already be clipped to the
+		 * bitmap.
+		 * @param colour The colour to fill with.
+		 */
+		static void fillData(u16* data, u16 bitmapWidth, const Rect& rect, const u16 colour);
+
+		/**
+		 * XOR every pixel in a rectangular region of bitmap data against
+		 * the specified colour, setting the top bit of each result.  Used by
+		 * subclasses that store their pixels as a single array of rows.
+		 * @param data Pointer to the first pixel of the bitmap.
+		 * @param bitmapWidth The width of the bitmap.
+		 * @param rect The region to XOR.  Must already be clipped to the
+		 * bitmap.
+		 * @param colour The colour to XOR against.
+		 */
+		static void xorData(u16* data, u16 bitmapWidth, const Rect& rect, const u16 colour);
 	};
 }
 
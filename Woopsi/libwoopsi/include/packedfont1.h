@@ -47,6 +47,8 @@ namespace WoopsiUI {
 		 * @param pixelData The font-specific pixel data.
 		 * @param pixelsPerRow The number of pixels to render per row (for this
 		 * character).
+		 * @param spans The character's runs of solid pixels, sorted by row.
+		 * @param spanCount The number of runs in the spans array.
 		 * @param bitmap Bitmap to draw to.
 		 * @param colour The colour to draw with.  If this is 0 the font's
 		 * default colour will be used.
@@ -59,10 +61,21 @@ namespace WoopsiUI {
 		 */
 		void renderChar(
 			const u16* pixelData, u16 pixelsPerRow,
+			const GlyphSpan* spans, u16 spanCount,
 			MutableBitmapBase* bitmap,
 			u16 colour,
 			s16 x, s16 y,
 			u16 clipX1, u16 clipY1, u16 clipX2, u16 clipY2);
+
+	protected:
+
+		/**
+		 * Append the runs of solid pixels in a character to the span list.
+		 * @param pixelData The font-specific pixel data.
+		 * @param pixelsPerRow The number of pixels per row for this character.
+		 * @param spans The list to append the runs to.
+		 */
+		void createGlyphSpans(const u16* pixelData, u16 pixelsPerRow, WoopsiArray<GlyphSpan>* spans) const;
 	};
 }
 
@@ -7,6 +7,7 @@
 
 #include <nds.h>
 #include "fontbase.h"
+#include "woopsiarray.h"
 
 namespace WoopsiUI {
 
@@ -17,6 +18,17 @@ namespace WoopsiUI {
 	class PackedFontBase : public FontBase
 	{
 	public:
+
+		/**
+		 * A horizontal run of solid pixels within a glyph, relative to the
+		 * top-left corner of the glyph.
+		 */
+		typedef struct {
+			u8 x;								/**< X co-ordinate of the start of the run. */
+			u8 y;								/**< Row that contains the run. */
+			u8 width;							/**< Number of pixels in the run. */
+		} GlyphSpan;
+
 		/**
 		 * Constructor.
 		 * @param first Ascii index of first character in glphyDdata.
@@ -44,7 +56,14 @@ namespace WoopsiUI {
 			  _first(first), _last(last),
 			  _glyphData(glyphData), _glyphOffset(glyphOffset), _glyphWidth(glyphWidth),
 			  _fontWidth(0), _spWidth(spWidth),
-			  _fontTop(fontTop), _widMax(fixedWidth) { };
+			  _fontTop(fontTop), _widMax(fixedWidth),
+			  _glyphSpans(NULL), _glyphSpanStart(NULL), _glyphSpanCount(NULL),
+			  _advances(NULL) { };
+
+		/**
+		 * Destructor.
+		 */
+		virtual ~PackedFontBase();
 
 		/**
 		 * Makes this font fixed-width, though doesn't allow the spacing to be
@@ -53,7 +72,15 @@ namespace WoopsiUI {
 		 * @param fontWidth Font width to use (0 for proportional, 1 for
 		 * wide-enough).
 		 */
-		inline void setFontWidth(u8 fontWidth) { _fontWidth = (fontWidth && (fontWidth < _widMax)) ? _widMax : fontWidth; };
+		inline void setFontWidth(u8 fontWidth) {
+			_fontWidth = (fontWidth && (fontWidth < _widMax)) ? _widMax : fontWidth;
+
+			// Character widths have changed
+			delete[] _advances;
+			_advances = NULL;
+
+			invalidateWidths();
+		};
 
 		/**
 		 * Draw an individual character of the font to the specified bitmap.
@@ -125,6 +152,16 @@ namespace WoopsiUI {
 		 */
 		virtual u8 getCharWidth(u32 letter) const;
 
+		/**
+		 * Get a table of the widths of the characters in the font.
+		 * @param first Populated with the first character in the table.
+		 * @param count Populated with the number of entries in the table.
+		 * @param defaultWidth Populated with the width of every character
+		 * outside the table.
+		 * @return Pointer to the table.
+		 */
+		virtual const u8* getAdvanceTable(u32& first, u32& count, u8& defaultWidth) const;
+
 		/**
 		 * Get the top of an individual character (constant for a packedfont).
 		 * @param letter The character to get the width of.
@@ -155,6 +192,8 @@ namespace WoopsiUI {
 		 * @param pixelData The font-specific pixel data.
 		 * @param pixelsPerRow The number of pixels to render per row (for this
 		 * character).
+		 * @param spans The character's runs of solid pixels, sorted by row.
+		 * @param spanCount The number of runs in the spans array.
 		 * @param bitmap The bitmap to draw to.
 		 * @param colour The colour to draw with.  If this is 0 the font's
 		 * default colour will be used.
@@ -167,6 +206,7 @@ namespace WoopsiUI {
 		 */
 		virtual void renderChar(
 			const u16* pixelData, u16 pixelsPerRow,
+			const GlyphSpan* spans, u16 spanCount,
 			MutableBitmapBase* bitmap,
 			u16 colour,
 			s16 x, s16 y,
@@ -183,6 +223,66 @@ namespace WoopsiUI {
 		u8 _spWidth;				/**< Width of a blank space. */
 		u8 _fontTop;				/**< Constant Top of the packed font. */
 		u8 _widMax;					/**< The maximum width of a character in the font. */
+
+		/**
+		 * Append the runs of solid pixels in a character to the span list.
+		 * Runs must be added in row order, left to right.
+		 * @param pixelData The font-specific pixel data.
+		 * @param pixelsPerRow The number of pixels per row for this character.
+		 * @param spans The list to append the runs to.
+		 */
+		virtual void createGlyphSpans(const u16* pixelData, u16 pixelsPerRow, WoopsiArray<GlyphSpan>* spans) const = 0;
+
+		/**
+		 * Clip a run of solid pixels to the clipping rectangle.
+		 * @param span The run to clip.
+		 * @param x The x co-ordinate of the character.
+		 * @param clipX1 The left edge of the clipping rectangle.
+		 * @param clipX2 The right edge of the clipping rectangle.
+		 * @param x1 Populated with the x co-ordinate of the start of the
+		 * clipped run.
+		 * @param x2 Populated with the x co-ordinate of the end of the clipped
+		 * run.
+		 * @return True if any part of the run is visible.
+		 */
+		inline bool clipSpan(const GlyphSpan& span, s16 x, u16 clipX1, u16 clipX2, s32& x1, s32& x2) const {
+			x1 = x + span.x;
+			x2 = x1 + span.width - 1;
+
+			if (x1 < clipX1) x1 = clipX1;
+			if (x2 > clipX2) x2 = clipX2;
+
+			return x1 <= x2;
+		};
+
+	private:
+		WoopsiArray<GlyphSpan>* _glyphSpans;	/**< Runs of solid pixels for all cached characters. */
+		s32* _glyphSpanStart;					/**< Index of each character's first run, or -1 if not yet cached. */
+		u16* _glyphSpanCount;					/**< Number of runs in each cached character. */
+		mutable u8* _advances;					/**< Width of each character, created when first needed. */
+
+		/**
+		 * Get the table of character widths, creating it if it has not been
+		 * created yet.
+		 * @return The width of each character from _first to _last.
+		 */
+		const u8* getAdvances() const;
+
+		/**
+		 * Get the runs of solid pixels for a character, creating them if
+		 * they have not been created yet.
+		 * @param letter The character to get runs for.  Must be within the
+		 * font's range.
+		 * @param count Populated with the number of runs.
+		 * @return Pointer to the first run, or NULL if the character has no
+		 * runs.
+		 */
+		const GlyphSpan* getGlyphSpans(u32 letter, u16& count);
+
+		/**
+		 * Copy constructor is private to prevent usage.
+		 */
+		inline PackedFontBase(const PackedFontBase& font) { };
 	};
 }
 
@@ -27,6 +27,12 @@ public:
 		_r = 0;
 		_start = 0;
 		_select = 0;
+
+#ifdef USING_HEADLESS
+		_headlessKeys = 0;
+#elif defined(USING_SDL)
+		_latchedKeys = 0;
+#endif
 	};
 
 	/**
@@ -238,84 +244,57 @@ public:
 			_select = -1;
 		}
 
-#else
-
-		const Uint8* keyState = SDL_GetKeyboardState(NULL);
-
-		if (keyState[SDL_SCANCODE_UP]) {
-			++_up;
-		} else if (_up > 0) {
-			_up = -1;
-		}
+#elif defined(USING_HEADLESS)
 
-		if (keyState[SDL_SCANCODE_DOWN]) {
-			++_down;
-		} else if (_down > 0) {
-			_down = -1;
-		}
+		// Use the state supplied by setHeadlessState()
+		updateKeys(_headlessKeys);
 
-		if (keyState[SDL_SCANCODE_LEFT]) {
-			++_left;
-		} else if (_left > 0) {
-			_left = -1;
-		}
+#else
 
-		if (keyState[SDL_SCANCODE_RIGHT]) {
-			++_right;
-		} else if (_right > 0) {
-			_right = -1;
-		}
+		const Uint8* keyState = SDL_GetKeyboardState(NULL);
 
-		if (keyState[SDL_SCANCODE_A]) {
-			++_l;
-		} else if (_l > 0) {
-			_l = -1;
-		}
+		// Keys that were pressed and released again since the last update
+		// are treated as held for this update, so that quick taps are not
+		// lost
+		u32 keys = _latchedKeys;
+		_latchedKeys = 0;
 
-		if (keyState[SDL_SCANCODE_S]) {
-			++_r;
-		} else if (_r > 0) {
-			_r = -1;
+		for (s32 i = KEY_CODE_UP; i <= KEY_CODE_SELECT; ++i) {
+			if (keyState[getScancode((KeyCode)i)]) keys |= 1 << i;
 		}
 
-		if (keyState[SDL_SCANCODE_Z]) {
-			++_a;
-		} else if (_a > 0) {
-			_a = -1;
-		}
+		updateKeys(keys);
 
-		if (keyState[SDL_SCANCODE_X]) {
-			++_b;
-		} else if (_b > 0) {
-			_b = -1;
-		}
+#endif
+	};
 
-		if (keyState[SDL_SCANCODE_C]) {
-			++_x;
-		} else if (_x > 0) {
-			_x = -1;
-		}
+#ifdef USING_HEADLESS
 
-		if (keyState[SDL_SCANCODE_V]) {
-			++_y;
-		} else if (_y > 0) {
-			_y = -1;
-		}
+	/**
+	 * Set the buttons that will be read as held by the next call to
+	 * update().  Only available in headless builds, which have no input
+	 * hardware.
+	 * @param keys Bitmask of held buttons.  Each button is represented by
+	 * the bit (1 << keyCode), where keyCode is a KeyCode value.
+	 */
+	inline void setHeadlessState(u32 keys) { _headlessKeys = keys; };
 
-		if (keyState[SDL_SCANCODE_D]) {
-			++_start;
-		} else if (_start > 0) {
-			_start = -1;
-		}
+#elif defined(USING_SDL)
 
-		if (keyState[SDL_SCANCODE_F]) {
-			++_select;
-		} else if (_select > 0) {
-			_select = -1;
+	/**
+	 * Ensure that the next call to update() sees a key as held, even if it
+	 * has been released again in the meantime.  Called by the hardware layer
+	 * when a key is pressed.  Keys that do not map to a DS button are
+	 * ignored.
+	 * @param scancode The SDL scancode of the pressed key.
+	 */
+	inline void latchKey(SDL_Scancode scancode) {
+		for (s32 i = KEY_CODE_UP; i <= KEY_CODE_SELECT; ++i) {
+			if (getScancode((KeyCode)i) == scancode) _latchedKeys |= 1 << i;
 		}
+	};
 
 #endif
-	};
 
 private:
 
@@ -340,6 +319,87 @@ private:
 	s32 _r;			/**< Is r held? */
 	s32 _start;		/**< Is start held? */
 	s32 _select;	/**< Is select held? */
+
+#ifdef USING_HEADLESS
+	u32 _headlessKeys;	/**< Buttons supplied by setHeadlessState() */
+#elif defined(USING_SDL)
+	u32 _latchedKeys;	/**< Buttons pressed since the last update */
+
+	/**
+	 * Get the SDL key that represents a DS button.
+	 * @param keyCode The button's key code.
+	 * @return The SDL scancode of the key.
+	 */
+	static inline SDL_Scancode getScancode(KeyCode keyCode) {
+		switch (keyCode) {
+			case KEY_CODE_UP:
+				return SDL_SCANCODE_UP;
+			case KEY_CODE_DOWN:
+				return SDL_SCANCODE_DOWN;
+			case KEY_CODE_LEFT:
+				return SDL_SCANCODE_LEFT;
+			case KEY_CODE_RIGHT:
+				return SDL_SCANCODE_RIGHT;
+			case KEY_CODE_A:
+				return SDL_SCANCODE_Z;
+			case KEY_CODE_B:
+				return SDL_SCANCODE_X;
+			case KEY_CODE_X:
+				return SDL_SCANCODE_C;
+			case KEY_CODE_Y:
+				return SDL_SCANCODE_V;
+			case KEY_CODE_L:
+				return SDL_SCANCODE_A;
+			case KEY_CODE_R:
+				return SDL_SCANCODE_S;
+			case KEY_CODE_START:
+				return SDL_SCANCODE_D;
+			case KEY_CODE_SELECT:
+				return SDL_SCANCODE_F;
+		}
+
+		// Included to silence dumb GCC warning
+		return SDL_SCANCODE_UP;
+	};
+#endif
+
+#ifdef USING_SDL
+
+	/**
+	 * Update every button's held time from a bitmask of held buttons.
+	 * @param keys Bitmask of held buttons.  Each button is represented by
+	 * the bit (1 << keyCode).
+	 */
+	inline void updateKeys(u32 keys) {
+		updateKey(_up, keys, KEY_CODE_UP);
+		updateKey(_down, keys, KEY_CODE_DOWN);
+		updateKey(_left, keys, KEY_CODE_LEFT);
+		updateKey(_right, keys, KEY_CODE_RIGHT);
+		updateKey(_l, keys, KEY_CODE_L);
+		updateKey(_r, keys, KEY_CODE_R);
+		updateKey(_a, keys, KEY_CODE_A);
+		updateKey(_b, keys, KEY_CODE_B);
+		updateKey(_x, keys, KEY_CODE_X);
+		updateKey(_y, keys, KEY_CODE_Y);
+		updateKey(_start, keys, KEY_CODE_START);
+		updateKey(_select, keys, KEY_CODE_SELECT);
+	};
+
+	/**
+	 * Update a button's held time from a bitmask of held buttons.
+	 * @param key The button's held time.
+	 * @param keys Bitmask of held buttons.
+	 * @param keyCode The button's key code.
+	 */
+	inline void updateKey(s32& key, u32 keys, KeyCode keyCode) {
+		if (keys & (1 << keyCode)) {
+			++key;
+		} else if (key > 0) {
+			key = -1;
+		}
+	};
+
+#endif
 };
 
 #endif
@@ -30,12 +30,6 @@ namespace WoopsiUI {
 		 */
 		Rect(s16 x, s16 y, s32 width, s32 height);
 
-		/**
-		 * Copy constructor.
-		 * @param rect Rect to copy.
-		 */
-		Rect(const Rect& rect);
-
 		/**
 		 * Create a rect object from the supplied co-ordinates.
 		 * @param x1 The x co-ordinate of the rect's top-left corner.
@@ -1,7 +1,7 @@
 #ifndef _RECT_CACHE_H_
 #define _RECT_CACHE_H_
 
-#include "woopsiarray.h"
+#include "region.h"
 #include "gadget.h"
 
 namespace WoopsiUI {
@@ -46,7 +46,7 @@ namespace WoopsiUI {
 		 * not overlapped by child gadgets.
 		 * @return The list of background regions.
 		 */
-		inline WoopsiArray<Rect>* getBackgroundRegions() { return _backgroundRegions; };
+		inline Region* getBackgroundRegions() { return _backgroundRegions; };
 
 		/**
 		 * Return the list of foreground regions.  These are regions that
@@ -55,31 +55,24 @@ namespace WoopsiUI {
 		 * including any regions that are actually overlapped by child gadgets.
 		 * @return The list of foreground regions.
 		 */
-		inline WoopsiArray<Rect>* getForegroundRegions() { return _foregroundRegions; };
+		inline Region* getForegroundRegions() { return _foregroundRegions; };
 
 		/**
-		 * Works out which rectangles in the invalidRectangles list overlap this
-		 * gadget, then cuts the rectangles into smaller pieces.  The
-		 * overlapping pieces are pushed into validRects, and the
-		 * non-overlapping pieces are pushed back into the invalidRects vector.
-		 * @param invalidRectangles A vector of regions that need to be tested
-		 * for collisions against this gadget; they represent regions that need
-		 * to be redrawn.
-		 * @param validRects A vector of regions that represents areas of the
-		 * display that do not need to be redrawn.
+		 * Removes the area covered by this gadget from the supplied region.
+		 * @param region The region to remove this gadget from; it represents
+		 * areas that need to be redrawn.
 		 */
-		void splitRectangles(WoopsiArray<Rect>* invalidRectangles, WoopsiArray<Rect>* validRects) const;
+		void splitRectangles(Region* region) const;
 
 		/**
-		 * Move any rectangles from the visibleRects list that overlap this
-		 * gadget into the invisibleRects list.  Used during visible region
-		 * calculations.
-		 * @param visibleRects A vector of regions that are not overlapped.
-		 * @param invisibleRects A vector of regions that are overlapped.
-		 * @param gadget The gadget that requested the lists.
+		 * Remove any areas from the visibleRegion that are overlapped by
+		 * gadgets higher in the z-order than the specified gadget.  Used
+		 * during visible region calculations.
+		 * @param visibleRegion The region that is not overlapped.
+		 * @param gadget The gadget that requested the region.
 		 * @see splitRectangles()
 		 */
-		void removeOverlappedRects(WoopsiArray<Rect>* visibleRects, WoopsiArray<Rect>* invisibleRects, const Gadget* gadget) const;
+		void removeOverlappedRects(Region* visibleRegion, const Gadget* gadget) const;
 
 		/**
 		 * Marks all foreground rects dirty.  All rects are sent to the
@@ -98,8 +91,8 @@ namespace WoopsiUI {
 		void markRectDamaged(const Rect& rect) const;
 
 	private:
-		WoopsiArray<Rect>* _foregroundRegions;				/**< List of the gadget's visible regions */
-		WoopsiArray<Rect>* _backgroundRegions;				/**< List of the gadget's visible regions with child rects removed */
+		Region* _foregroundRegions;							/**< The gadget's visible region */
+		Region* _backgroundRegions;							/**< The gadget's visible region with child rects removed */
 		const Gadget* _gadget;								/**< Owning gadget */
 		bool _foregroundInvalid;							/**< True if the foreground cache needs refreshing */
 		bool _backgroundInvalid;							/**< True if the background cache needs refreshing */
@@ -0,0 +1,218 @@
+#ifndef _REGION_H_
+#define _REGION_H_
+
+#include <nds.h>
+#include "rect.h"
+#include "woopsiarray.h"
+
+namespace WoopsiUI {
+
+	/**
+	 * Number of rects that a region can hold before it allocates memory from
+	 * the heap.
+	 */
+	const s32 REGION_INLINE_RECT_COUNT = 8;
+
+	/**
+	 * An arbitrary area of the display described as a set of non-overlapping
+	 * rectangles.  The rectangles are stored in "banded" form: they are sorted
+	 * top-to-bottom and then left-to-right, and every rectangle in a band
+	 * shares the same y co-ordinate and height.  Vertically adjacent bands
+	 * with identical spans are merged together.  This keeps the number of
+	 * rectangles small and allows union, subtraction and intersection to be
+	 * performed in a single pass over both operands rather than by testing
+	 * every rectangle against every other rectangle.
+	 */
+	class Region {
+	public:
+
+		/**
+		 * Constructor.  Creates an empty region.
+		 */
+		Region();
+
+		/**
+		 * Constructor.  Creates a region containing the supplied rect.
+		 * @param rect The rect that the region will contain.
+		 */
+		Region(const Rect& rect);
+
+		/**
+		 * Copy constructor.
+		 * @param region The region to copy.
+		 */
+		Region(const Region& region);
+
+		/**
+		 * Destructor.
+		 */
+		inline ~Region() { };
+
+		/**
+		 * Assignment operator.
+		 * @param region The region to copy.
+		 * @return A reference to this region.
+		 */
+		Region& operator=(const Region& region);
+
+		/**
+		 * Get the number of rects that make up the region.
+		 * @return The number of rects in the region.
+		 */
+		inline const s32 size() const { return _rects.size(); };
+
+		/**
+		 * Get the rect at the specified index.  Does not perform bounds
+		 * checking.
+		 * @param index The index of the rect.
+		 * @return The rect at the specified index.
+		 */
+		inline const Rect& at(const s32 index) const { return _rects.at(index); };
+
+		/**
+		 * Check if the region contains any rects.
+		 * @return True if the region is empty.
+		 */
+		inline bool isEmpty() const { return _rects.size() == 0; };
+
+		/**
+		 * Remove all rects from the region.
+		 */
+		inline void clear() { _rects.clear(); };
+
+		/**
+		 * Get the smallest rect that contains the entire region.  If the
+		 * region is empty the rect will have no dimensions.
+		 * @param rect Rect to populate with the bounds of the region.
+		 */
+		void getBounds(Rect& rect) const;
+
+		/**
+		 * Check if the region contains the specified point.
+		 * @param x The x co-ordinate of the point.
+		 * @param y The y co-ordinate of the point.
+		 * @return True if the point falls within the region.
+		 */
+		bool contains(s16 x, s16 y) const;
+
+		/**
+		 * Check if any part of the region intersects the specified rect.
+		 * @param rect The rect to check.
+		 * @return True if the rect intersects the region.
+		 */
+		bool intersects(const Rect& rect) const;
+
+		/**
+		 * Add a rect to the region.
+		 * @param rect The rect to add.
+		 */
+		void addRect(const Rect& rect);
+
+		/**
+		 * Add another region to this region.
+		 * @param region The region to add.
+		 */
+		void addRegion(const Region& region);
+
+		/**
+		 * Remove a rect from the region.
+		 * @param rect The rect to remove.
+		 */
+		void subtractRect(const Rect& rect);
+
+		/**
+		 * Remove another region from this region.
+		 * @param region The region to remove.
+		 */
+		void subtractRegion(const Region& region);
+
+		/**
+		 * Clip the region so that it only contains the areas that also fall
+		 * within the specified rect.
+		 * @param rect The rect to clip to.
+		 */
+		void intersectRect(const Rect& rect);
+
+		/**
+		 * Clip the region so that it only contains the areas that also fall
+		 * within the specified region.
+		 * @param region The region to clip to.
+		 */
+		void intersectRegion(const Region& region);
+
+		/**
+		 * Move every rect in the region by the specified distances.
+		 * @param x The horizontal distance to move.
+		 * @param y The vertical distance to move.
+		 */
+		void translate(s16 x, s16 y);
+
+	private:
+
+		/**
+		 * Operations that can be performed when combining two regions.
+		 */
+		enum Operation {
+			OPERATION_UNION = 0,				/**< Keep areas in either region. */
+			OPERATION_SUBTRACT = 1,				/**< Keep areas only in the first region. */
+			OPERATION_INTERSECT = 2				/**< Keep areas in both regions. */
+		};
+
+		typedef WoopsiArray<Rect, REGION_INLINE_RECT_COUNT> RectArray;
+
+		RectArray _rects;						/**< Banded list of rects in the region. */
+
+		static RectArray _combineOutput;		/**< Working list shared by all regions when combining, so that its capacity is only allocated once. */
+
+		/**
+		 * Combine the region with a banded list of rects and replace the
+		 * contents of the region with the result.  The result is built in
+		 * a shared working list and then copied into the region, which
+		 * reuses the region's existing capacity.
+		 * @param rects Banded list of rects to combine with.
+		 * @param count The number of rects in the list.
+		 * @param operation The operation to perform.
+		 */
+		void combine(const Rect* rects, s32 count, Operation operation);
+
+		/**
+		 * Find the end of the band that starts at the specified index.
+		 * @param rects Banded list of rects.
+		 * @param count The number of rects in the list.
+		 * @param start Index of the first rect in the band.
+		 * @return Index of the first rect after the band.
+		 */
+		static s32 getBandEnd(const Rect* rects, s32 count, s32 start);
+
+		/**
+		 * Combine the spans of two bands and append the result to the
+		 * output as a new band, merging it with the previous band if the two
+		 * are identical and vertically adjacent.
+		 * @param a The first band's rects.
+		 * @param aCount The number of rects in the first band.
+		 * @param b The second band's rects.
+		 * @param bCount The number of rects in the second band.
+		 * @param top The y co-ordinate of the top of the new band.
+		 * @param bottom The y co-ordinate below the bottom of the new band.
+		 * @param operation The operation to perform.
+		 * @param output The list to append the band to.
+		 * @param previousBand Index of the first rect of the previous band
+		 * in the output list.  Updated if a new band is added.
+		 */
+		static void combineBands(const Rect* a, s32 aCount, const Rect* b, s32 bCount, s32 top, s32 bottom, Operation operation, RectArray* output, s32& previousBand);
+
+		/**
+		 * Append a span to the band currently being built, merging it with
+		 * the preceding span if they touch.
+		 * @param x1 The x co-ordinate of the left of the span.
+		 * @param x2 The x co-ordinate to the right of the span.
+		 * @param top The y co-ordinate of the top of the band.
+		 * @param bottom The y co-ordinate below the bottom of the band.
+		 * @param output The list to append the span to.
+		 * @param bandStart Index of the first rect in the band being built.
+		 */
+		static void appendSpan(s32 x1, s32 x2, s32 top, s32 bottom, RectArray* output, s32 bandStart);
+	};
+}
+
+#endif
@@ -183,6 +183,22 @@ namespace WoopsiUI {
 			_listbox->sort();
 		};
 
+		/**
+		 * Start a batch of changes to the options.  See
+		 * ListBox::beginUpdate().
+		 */
+		inline void beginUpdate() {
+			_listbox->beginUpdate();
+		};
+
+		/**
+		 * End a batch of changes started with beginUpdate().
+		 */
+		inline void endUpdate() {
+			_listbox->endUpdate();
+			updateScrollbar();
+		};
+
 		/**
 		 * Get the total number of options.
 		 * @return The number of options.
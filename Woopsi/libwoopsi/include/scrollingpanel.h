@@ -80,6 +80,17 @@ namespace WoopsiUI {
 		 */
 		virtual inline const s32 getCanvasHeight() const { return _canvasHeight; };
 
+		/**
+		 * Gets the offset applied to child gadgets.  Children are positioned
+		 * on the virtual canvas, so the offset is the canvas position.
+		 * @param x Reference to an s16 to populate with the horizontal offset.
+		 * @param y Reference to an s16 to populate with the vertical offset.
+		 */
+		virtual inline void getChildOffset(s16& x, s16& y) const {
+			x = _canvasX;
+			y = _canvasY;
+		};
+
 		/**
 		 * Set whether or not horizontal scrolling is allowed.
 		 * @param allow True to allow horizontal scrolling; false to deny it.
@@ -166,10 +177,12 @@ namespace WoopsiUI {
 		virtual void onClick(s16 x, s16 y);
 
 		/**
-		 * Scroll all child gadgets by the specified amounts.  Actually uses the gadget's
-		 * moveTo() function to reposition them.
-		 * @param dx The horizontal distance to scroll.
-		 * @param dy The vertical distance to scroll.
+		 * Update child gadgets after the canvas has scrolled by the specified
+		 * amounts.  Children are positioned on the canvas, so they move with
+		 * it without being moved individually; this just discards their
+		 * cached positions and redraws them if the content was not scrolled.
+		 * @param dx The horizontal distance scrolled.
+		 * @param dy The vertical distance scrolled.
 		 */
 		void scrollChildren(s32 dx, s32 dy);
 
@@ -165,6 +165,12 @@ namespace WoopsiUI {
 		 */
 		virtual void handleScrollEvent(Gadget& source, const WoopsiPoint& delta);
 
+		/**
+		 * Handles events raised by its sub-gadgets.
+		 * @param source The gadget that raised the event.
+		 */
+		virtual void handleActionEvent(Gadget& source);
+
 		/**
 		 * Check if the textbox opens the keyboard popup when double-clicked.
 		 * @return True if the keyboard pops up; false if not.
@@ -13,6 +13,11 @@ namespace WoopsiUI {
 	 * variable-width UTF-8 encoding to represent its characters.  This means
 	 * that it is not possible to iterate over a WoopsiString in the same way
 	 * that you would iterate over a char array.
+	 *
+	 * The iterator does not allocate any memory, so it is cheap to create on
+	 * the stack:
+	 *
+	 * StringIterator iterator(&string);
 	 */
 	class StringIterator {
 	public:
@@ -71,7 +76,13 @@ namespace WoopsiUI {
 		 * Get the codepoint in the string at the iterator's current point.
 		 * @return The current character in the string.
 		 */
-		u32 getCodePoint() const;
+		inline u32 getCodePoint() const {
+
+			// ASCII characters are a single byte and need no decoding
+			if ((unsigned char)*_currentChar < 0x80) return (unsigned char)*_currentChar;
+
+			return getMultiByteCodePoint();
+		};
 
 		/**
 		 * Get the integer value represented by the sequence of digits at the
@@ -104,6 +115,13 @@ namespace WoopsiUI {
 		void iterateBackwardsTo(s32 index);
 		
 	private:
+
+		/**
+		 * Decode the multi-byte codepoint at the iterator's current point.
+		 * @return The current character in the string.
+		 */
+		u32 getMultiByteCodePoint() const;
+
 		const WoopsiString* _string;		/**< String being iterated over. */
 		const char* _currentChar;	/**< Pointer to the current position of the iterator. */
 		s32 _currentIndex;					/**< Iterator's current index within the string. */
@@ -11,6 +11,16 @@ class Stylus {
 public:
 
 	static const s32 STYLUS_REPEAT_TIME = 10;	/**< VBLs before the stylus repeats. */
+	static const s32 STYLUS_MAX_SAMPLES = 32;	/**< Maximum positions recorded per VBL. */
+
+	/**
+	 * A position that the stylus passed through while held.
+	 */
+	typedef struct {
+		s16 x;						/**< X co-ordinate of the stylus. */
+		s16 y;						/**< Y co-ordinate of the stylus. */
+		u32 time;					/**< Time the position was recorded, in milliseconds. */
+	} Sample;
 
 	/**
 	 * Constructor.
@@ -23,6 +33,21 @@ public:
 		_oldY = 0;
 		_isDoubleClick = false;
 		_doubleClickTimeout = 0;
+		_sampleCount = 0;
+		_areSamplesStale = true;
+
+#if defined(USING_SDL) && !defined(USING_HEADLESS)
+		_isPressLatched = false;
+#else
+		_time = 0;
+		_timeRemainder = 0;
+#endif
+
+#ifdef USING_HEADLESS
+		_headlessX = 0;
+		_headlessY = 0;
+		_isHeadlessHeld = false;
+#endif
 	};
 
 	/**
@@ -86,6 +111,23 @@ public:
 	 */
 	inline s16 getVY() const { return _vY; };
 
+	/**
+	 * Get the number of positions that the stylus passed through while held
+	 * since the previous VBL.  The positions run from the oldest to the
+	 * newest, and the last is always the current position.  SDL builds record
+	 * every mouse movement between VBLs; the DS can only read the stylus once
+	 * per VBL, so there is at most one sample.
+	 * @return The number of samples.
+	 */
+	inline s32 getSampleCount() const { return _sampleCount; };
+
+	/**
+	 * Get a position that the stylus passed through since the previous VBL.
+	 * @param index The index of the sample.
+	 * @return The sample.
+	 */
+	inline const Sample& getSample(s32 index) const { return _samples[index]; };
+
 	/**
 	 * Update the stylus' state to match the latest DS state.  The libnds
 	 * function scanKeys() must be called before this method.
@@ -97,6 +139,13 @@ public:
 
 		if (_doubleClickTimeout > 0) --_doubleClickTimeout;
 
+		// Discard the previous VBL's samples unless addSample() has already
+		// started a new list
+		if (_areSamplesStale) _sampleCount = 0;
+		_areSamplesStale = true;
+
+		u32 time;
+
 #ifndef USING_SDL
 
 		s32 pressed = keysDown();	// buttons pressed this loop
@@ -132,6 +181,20 @@ public:
 			_vY = _y - _oldY;
 		}
 
+		time = advanceTime();
+
+#else
+
+#ifdef USING_HEADLESS
+
+		// Use the state supplied by setHeadlessState(); co-ordinates are
+		// offset to match the SDL window layout
+		int mouseX = _headlessX;
+		int mouseY = _headlessY + SCREEN_HEIGHT;
+		bool isMouseHeld = _isHeadlessHeld;
+
+		time = advanceTime();
+
 #else
 
 		// Read mouse state
@@ -139,9 +202,18 @@ public:
 		int mouseY;
 		
 		int mouseState = SDL_GetMouseState(&mouseX, &mouseY);
+
+		// A press that was released again before this VBL still counts as a
+		// press, so that quick taps are not lost
+		bool isMouseHeld = ((mouseState & SDL_BUTTON_LEFT) != 0) || _isPressLatched;
+		_isPressLatched = false;
+
+		time = SDL_GetTicks();
+
+#endif
 		
 		// Check buttons
-		if (mouseState & SDL_BUTTON_LEFT) {
+		if (isMouseHeld) {
 
 			// Stylus is held
 			++_touchedTime;
@@ -168,8 +240,63 @@ public:
 		}
 
 #endif
+
+		if (_touchedTime > 0) {
+
+			// Ensure that the path ends at the current position
+			if ((_sampleCount == 0) || (_samples[_sampleCount - 1].x != _x) || (_samples[_sampleCount - 1].y != _y)) {
+				appendSample(_x, _y, time);
+			}
+		} else {
+			_sampleCount = 0;
+		}
+	};
+
+#if defined(USING_SDL) && !defined(USING_HEADLESS)
+
+	/**
+	 * Record a position that the stylus passed through between VBLs.
+	 * Called by the hardware layer for each mouse event received while the
+	 * button is held.
+	 * @param x The x co-ordinate of the stylus on the bottom screen.
+	 * @param y The y co-ordinate of the stylus on the bottom screen.
+	 * @param time The time of the event, in milliseconds.
+	 */
+	inline void addSample(s16 x, s16 y, u32 time) {
+		if (_areSamplesStale) {
+			_sampleCount = 0;
+			_areSamplesStale = false;
+		}
+
+		appendSample(x, y, time);
+	};
+
+	/**
+	 * Ensure that the next call to update() sees the stylus as held, even if
+	 * it has been released again in the meantime.  Called by the hardware
+	 * layer when the mouse button is pressed.
+	 */
+	inline void latchPress() { _isPressLatched = true; };
+
+#endif
+
+#ifdef USING_HEADLESS
+
+	/**
+	 * Set the stylus state that will be read by the next call to update().
+	 * Only available in headless builds, which have no input hardware.
+	 * @param x The x co-ordinate of the stylus on the bottom screen.
+	 * @param y The y co-ordinate of the stylus on the bottom screen.
+	 * @param isHeld True if the stylus is held down.
+	 */
+	inline void setHeadlessState(s16 x, s16 y, bool isHeld) {
+		_headlessX = x;
+		_headlessY = y;
+		_isHeadlessHeld = isHeld;
 	};
 
+#endif
+
 private:
 	s32 _touchedTime;			/**< Time that stylus has been pressed */
 	s16 _x;						/**< X co-ord of the stylus */
@@ -180,6 +307,57 @@ private:
 	s16 _vY;					/**< Y distance moved */
 	s32 _doubleClickTimeout;	/**< Time until double-clicks aren't detected */
 	s32 _isDoubleClick;			/**< Set if double-click is detected */
+	Sample _samples[STYLUS_MAX_SAMPLES];	/**< Positions passed through since the previous VBL */
+	s32 _sampleCount;			/**< Number of samples */
+	bool _areSamplesStale;		/**< True if the samples belong to the previous VBL */
+
+#if defined(USING_SDL) && !defined(USING_HEADLESS)
+	bool _isPressLatched;		/**< Set if the button was pressed since the last update */
+#else
+	u32 _time;					/**< Milliseconds elapsed, derived from the VBL count */
+	u32 _timeRemainder;			/**< Microseconds elapsed beyond _time */
+
+	/**
+	 * Advance the time by the length of one VBL.
+	 * @return The new time in milliseconds.
+	 */
+	inline u32 advanceTime() {
+
+		// The DS refreshes at 59.83Hz, so each VBL lasts 16.715ms
+		_time += 16;
+		_timeRemainder += 715;
+
+		if (_timeRemainder >= 1000) {
+			++_time;
+			_timeRemainder -= 1000;
+		}
+
+		return _time;
+	};
+#endif
+
+	/**
+	 * Add a sample to the end of the list.  If the list is full the newest
+	 * sample replaces the last one, so the path always ends at the most
+	 * recent position.
+	 * @param x The x co-ordinate of the sample.
+	 * @param y The y co-ordinate of the sample.
+	 * @param time The time of the sample.
+	 */
+	inline void appendSample(s16 x, s16 y, u32 time) {
+		if (_sampleCount == STYLUS_MAX_SAMPLES) --_sampleCount;
+
+		_samples[_sampleCount].x = x;
+		_samples[_sampleCount].y = y;
+		_samples[_sampleCount].time = time;
+		++_sampleCount;
+	};
+
+#ifdef USING_HEADLESS
+	s16 _headlessX;				/**< X co-ord supplied by setHeadlessState() */
+	s16 _headlessY;				/**< Y co-ord supplied by setHeadlessState() */
+	bool _isHeadlessHeld;		/**< Held state supplied by setHeadlessState() */
+#endif
 };
 
 #endif
@@ -5,17 +5,21 @@
 #include "gadget.h"
 #include "graphics.h"
 #include "gadgetstyle.h"
+#include "gadgeteventhandler.h"
 
 namespace WoopsiUI {
 
 	class Bitmap;
 	class BitmapBase;
+	class WoopsiTimer;
 
 	/**
 	 * The SuperBitmap class provides a set of 2D drawing tools and a bitmap in RAM to draw on.
 	 * The class manifests itself as a gadget that can be scrolled around using the stylus.
+	 * Anything drawn to the bitmap is automatically redrawn on the next VBL; only the area
+	 * of the bitmap that has changed is redrawn.
 	 */
-	class SuperBitmap : public Gadget {
+	class SuperBitmap : public Gadget, public GadgetEventHandler {
 
 	public:
 
@@ -79,11 +83,25 @@ namespace WoopsiUI {
 		 */
 		s16 getBitmapY() const;
 
+		/**
+		 * Mark the area of the gadget showing any part of the bitmap that has
+		 * been drawn to as damaged.  Called automatically every VBL, but can
+		 * be called to redraw changes sooner.
+		 */
+		void flushDirtyRect();
+
+		/**
+		 * Handle any child events.
+		 * @param source The gadget that raised the event.
+		 */
+		void handleActionEvent(Gadget& source);
+
 	protected:
 		s32 _bitmapX;									/**< X co-ordinate of the bitmap relative to the gadget */
 		s32 _bitmapY;									/**< Y co-ordinate of the bitmap relative to the gadget */
 		Bitmap* _bitmap;								/**< Bitmap */
 		Graphics* _graphics;							/**< Graphics object for drawing to bitmap */
+		WoopsiTimer* _timer;							/**< Flushes changes to the bitmap every VBL */
 
 		/**
 		 * Draw the area of this gadget that falls within the clipping region.
@@ -117,6 +135,14 @@ namespace WoopsiUI {
 		 */
 		virtual void onClick(s16 x, s16 y);
 
+		/**
+		 * Move the bitmap within the gadget.  The pixels already on screen
+		 * are scrolled and only the revealed areas are redrawn.
+		 * @param x The new x co-ordinate of the bitmap.
+		 * @param y The new y co-ordinate of the bitmap.
+		 */
+		void scrollBitmap(s32 x, s32 y);
+
 		/**
 		 * Destructor.
 		 */
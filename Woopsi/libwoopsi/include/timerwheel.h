@@ -0,0 +1,185 @@
+#ifndef _TIMER_WHEEL_H_
+#define _TIMER_WHEEL_H_
+
+#include <nds.h>
+
+namespace WoopsiUI {
+
+	class TimerWheel;
+
+	/**
+	 * Number of bits of the expiry time handled by each level of the timer
+	 * wheel.
+	 */
+	const s32 TIMER_WHEEL_BITS = 6;
+
+	/**
+	 * Number of slots in each level of the timer wheel.
+	 */
+	const s32 TIMER_WHEEL_SLOTS = 1 << TIMER_WHEEL_BITS;
+
+	/**
+	 * Number of levels in the timer wheel.  Timers further in the future than
+	 * the wheel can represent are parked in the top level until they come
+	 * into range.
+	 */
+	const s32 TIMER_WHEEL_LEVELS = 4;
+
+	/**
+	 * Base class for anything that can be scheduled on a TimerWheel.  Handles
+	 * are not gadgets and contain nothing but the list pointers the wheel
+	 * needs, so they are cheap enough to embed in any object.  Subclasses
+	 * implement onTimerExpired() to receive notifications.
+	 */
+	class TimerHandle {
+	public:
+
+		/**
+		 * Constructor.
+		 */
+		inline TimerHandle() {
+			_next = NULL;
+			_prev = NULL;
+			_list = NULL;
+			_wheel = NULL;
+			_expiryTime = 0;
+		};
+
+		/**
+		 * Destructor.  Cancels the timer if it is armed.
+		 */
+		virtual ~TimerHandle();
+
+		/**
+		 * Check if the timer is waiting to expire.
+		 * @return True if the timer is armed.
+		 */
+		inline bool isArmed() const { return _wheel != NULL; };
+
+		/**
+		 * Get the wheel time at which the timer will expire.  Only valid if
+		 * the timer is armed.
+		 * @return The expiry time.
+		 */
+		inline u32 getExpiryTime() const { return _expiryTime; };
+
+		/**
+		 * Stop the timer from expiring.  Does nothing if the timer is not
+		 * armed.
+		 */
+		void cancel();
+
+	protected:
+
+		/**
+		 * Called by the wheel when the timer expires.  The timer is no
+		 * longer armed when this is called, so it can be re-armed from
+		 * within the method.
+		 */
+		virtual void onTimerExpired() = 0;
+
+	private:
+		friend class TimerWheel;
+
+		TimerHandle* _next;					/**< Next handle in the slot. */
+		TimerHandle* _prev;					/**< Previous handle in the slot. */
+		TimerHandle** _list;				/**< Head of the slot containing the handle. */
+		TimerWheel* _wheel;					/**< Wheel the handle is armed on. */
+		u32 _expiryTime;					/**< Wheel time at which the handle expires. */
+
+		/**
+		 * Copy constructor is private to prevent usage.
+		 */
+		inline TimerHandle(const TimerHandle& timerHandle) { };
+	};
+
+	/**
+	 * Hierarchical timer wheel.  Advanced once per VBL by Woopsi.  Arming and
+	 * cancelling a timer are constant-time operations, and advancing the
+	 * wheel only touches the timers that expire on that VBL; every timer due
+	 * on the same VBL sits in the same slot and is fired in a single pass.
+	 *
+	 * Level 0 holds timers due within the next TIMER_WHEEL_SLOTS VBLs, one
+	 * slot per VBL.  Each higher level covers TIMER_WHEEL_SLOTS times the
+	 * range of the level below.  Whenever a lower level wraps around, the
+	 * next slot of the level above is emptied and its timers are
+	 * redistributed into the lower levels.
+	 */
+	class TimerWheel {
+	public:
+
+		/**
+		 * Constructor.
+		 */
+		TimerWheel();
+
+		/**
+		 * Destructor.  Any armed timers are disarmed.
+		 */
+		~TimerWheel();
+
+		/**
+		 * Arm a timer.  If the timer is already armed it is rescheduled.
+		 * @param handle The timer to arm.
+		 * @param delay Number of VBLs until the timer expires.  Timers
+		 * cannot expire on the current VBL, so a delay of 0 is treated as 1.
+		 */
+		void arm(TimerHandle* handle, u32 delay);
+
+		/**
+		 * Disarm a timer.  Does nothing if the timer is not armed.
+		 * @param handle The timer to disarm.
+		 */
+		void cancel(TimerHandle* handle);
+
+		/**
+		 * Advance the wheel by one VBL and fire any timers that expire.
+		 */
+		void tick();
+
+		/**
+		 * Get the number of VBLs that the wheel has advanced by.  The count
+		 * wraps around on overflow.
+		 * @return The current wheel time.
+		 */
+		inline u32 getTime() const { return _time; };
+
+	private:
+		u32 _time;															/**< Current wheel time. */
+		TimerHandle* _slots[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];		/**< Slot list heads. */
+
+		/**
+		 * Add an armed handle to the slot that matches its expiry time.
+		 * @param handle The handle to add.
+		 */
+		void insert(TimerHandle* handle);
+
+		/**
+		 * Append a handle to the end of a slot list.
+		 * @param list The head of the slot list.
+		 * @param handle The handle to append.
+		 */
+		static void append(TimerHandle** list, TimerHandle* handle);
+
+		/**
+		 * Remove a handle from the slot list that contains it.
+		 * @param handle The handle to remove.
+		 */
+		static void unlink(TimerHandle* handle);
+
+		/**
+		 * Empty a slot in one of the upper levels and redistribute its
+		 * handles into the lower levels.
+		 * @param level The level containing the slot.
+		 * @param slot The index of the slot.
+		 */
+		void cascade(s32 level, s32 slot);
+
+		/**
+		 * Copy constructor is private to prevent usage.
+		 */
+		inline TimerWheel(const TimerWheel& timerWheel) { };
+	};
+}
+
+#endif
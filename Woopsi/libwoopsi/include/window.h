@@ -42,8 +42,25 @@ namespace WoopsiUI {
 		 */
 		const WoopsiString& getTitle() { return _title; };
 
+		/**
+		 * Set whether or not the window is moved live as it is dragged.  If
+		 * false, the window is represented by a XOR rect whilst it is dragged
+		 * and only moves when it is released.  Live dragging copies the
+		 * window to its new position on every frame, so only the areas it
+		 * uncovers need to be redrawn.
+		 * @param isOpaqueDrag True to move the window live as it is dragged.
+		 */
+		inline void setOpaqueDrag(bool isOpaqueDrag) { _isOpaqueDrag = isOpaqueDrag; };
+
+		/**
+		 * Check if the window is moved live as it is dragged.
+		 * @return True if the window is moved live as it is dragged.
+		 */
+		inline bool isOpaqueDrag() const { return _isOpaqueDrag; };
+
 	protected:
 		WoopsiString _title;							/**< Title of the window */
+		bool _isOpaqueDrag;								/**< True if the window moves live as it is dragged */
 
 		/**
 		 * Draw the area of this gadget that falls within the clipping region.
@@ -54,12 +71,14 @@ namespace WoopsiUI {
 		virtual void drawBorder(GraphicsPort* port);
 
 		/**
-		 * Draws a XOR rect around the window.
+		 * Draws a XOR rect around the window unless opaque dragging is
+		 * enabled.
 		 */
 		virtual void onDragStart();
 		
 		/**
-		 * Draws the dragging XOR rect at the new co-ordinates.
+		 * Draws the dragging XOR rect at the new co-ordinates, or moves the
+		 * window there if opaque dragging is enabled.
 		 * @param x The x co-ordinate of the stylus.
 		 * @param y The y co-ordinate of the stylus.
 		 * @param vX The horizontal distance dragged.
@@ -69,9 +88,17 @@ namespace WoopsiUI {
 		
 		/**
 		 * Erases the XOR rect and moves the window to the new co-ordinates.
+		 * Does nothing if opaque dragging is enabled, as the window is
+		 * already in place.
 		 */
 		virtual void onDragStop();
 
+		/**
+		 * Draws the dragging XOR rect at the window's new co-ordinates.
+		 * Drawing it a second time erases it.
+		 */
+		void drawDragOutline();
+
 		/**
 		 * Destructor.
 		 */
@@ -9,10 +9,10 @@ namespace WoopsiUI {
 
 	class Screen;
 	class ContextMenu;
-	class WoopsiTimer;
 	class WoopsiKeyboardScreen;
 	class KeyboardEventHandler;
 	class DamagedRectManager;
+	class TimerWheel;
 
 	/**
 	 * Class providing a top-level gadget and an interface to the Woopsi gadget
@@ -58,22 +58,6 @@ namespace WoopsiUI {
 		 */
 		virtual bool flipScreens(Gadget* gadget);
 
-		/**
-		 * Add the supplied timer to the list of timers that receive VBL
-		 * notifications.  This is handled automatically by the WoopsiTimer
-		 * constructor and should not be used in user code.
-		 * @param timer A pointer to the timer to add to the VBL list.
-		 */
-		void registerForVBL(WoopsiTimer* timer);
-
-		/**
-		 * Remove the supplied timer from the list of timers that receive VBL
-		 * notifications.  This is handled automatically by the WoopsiTimer
-		 * destructor and should not be used in user code.
-		 * @param timer A pointer to the timer to remove from the VBL list.
-		 */
-		void unregisterFromVBL(WoopsiTimer* timer);
-
 		/**
 		 * Add a gadget to the list of gadgets to be deleted.  Must never be
 		 * called by anything other than the framework itself.
@@ -146,16 +130,23 @@ namespace WoopsiUI {
 		 */
 		DamagedRectManager* getDamagedRectManager() { return _damagedRectManager; };
 
+		/**
+		 * Get a pointer to the timer wheel.  The wheel advances once per VBL
+		 * and drives all WoopsiTimer gadgets and TimerHandle objects.
+		 * @return A pointer to the timer wheel.
+		 */
+		inline TimerWheel* getTimerWheel() { return _timerWheel; };
+
 	protected:
 		bool _lidClosed;									/**< Remembers the current state of the lid. */
 		
-		WoopsiArray<WoopsiTimer*> _vblListeners;			/**< Array of timers that receive VBL events. */
 		WoopsiArray<Gadget*> _deleteQueue;					/**< Array of gadgets awaiting deletion. */
 		u32 _vblCount;										/**< Count of VBLs since Woopsi was first run. */
 		ContextMenu* _contextMenu;							/**< Pointer to the context menu. */
 		Gadget* _clickedGadget;								/**< Pointer to the gadget that is clicked. */
 		WoopsiKeyboardScreen* _keyboardScreen;				/**< Screen containing the popup keyboard. */
 		DamagedRectManager* _damagedRectManager;			/**< Maintains damaged rect list and controls redraws. */
+		TimerWheel* _timerWheel;							/**< Schedules timers. */
 
 		/**
 		 * Initialise the application.  All initial GUI creation, hardware
@@ -173,7 +164,7 @@ namespace WoopsiUI {
 		 * to shut down SDL yourself.
 		 */
 		virtual inline void shutdown() {
-	#ifdef USING_SDL
+	#if defined(USING_SDL) && !defined(USING_HEADLESS)
 			SDL_Quit();
 	#endif
 		};
@@ -199,6 +190,13 @@ namespace WoopsiUI {
 		 */
 		void handleShiftClick(s16 x, s16 y, Gadget* gadget);
 
+		/**
+		 * Drag the clicked gadget through every position that the stylus
+		 * passed through since the previous VBL.  Used for gadgets that
+		 * receive the full drag path.
+		 */
+		void handleDragPath();
+
 		/**
 		 * Delete any gadgets in the deletion queue.
 		 */
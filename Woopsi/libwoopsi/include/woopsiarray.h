@@ -2,9 +2,22 @@
 #define _DYNAMIC_ARRAY_H_
 
 #include <nds.h>
+#include <string.h>
 
 const s32 DYNAMIC_ARRAY_SIZE = 32;
 
+/**
+ * True if values of type T can be moved around with memmove() rather than by
+ * assignment.  Compilers without a suitable builtin always use assignment.
+ */
+#if defined(__clang__) || (defined(__GNUC__) && (__GNUC__ >= 5))
+#define WOOPSI_ARRAY_IS_TRIVIAL(T) __is_trivially_copyable(T)
+#elif defined(__GNUC__)
+#define WOOPSI_ARRAY_IS_TRIVIAL(T) __has_trivial_copy(T)
+#else
+#define WOOPSI_ARRAY_IS_TRIVIAL(T) false
+#endif
+
 /**
  * Class providing a dynamic array; that is, an array that will automatically
  * grow to accommodate new data.  It provides a fast way to randomly access
@@ -12,14 +25,29 @@ const s32 DYNAMIC_ARRAY_SIZE = 32;
  * of the STL vector class without any of the overhead of including an STL
  * class.
  *
+ * The N template parameter gives the number of values that can be stored
+ * inside the array object itself.  The array only allocates memory from the
+ * heap once it grows beyond that size, so short-lived arrays that rarely hold
+ * many values can be created on the stack without touching the heap at all.
+ * An array with inline storage can be passed to anything that expects a
+ * WoopsiArray<T>.  Arrays without inline storage do not allocate any memory
+ * until the first value is added or reserve() is called.
+ *
  * If the data to be stored will store a lot of data that will predominantly
  * be read sequentially, consider using the LinkedList class instead.  Resizing
  * the list is an expensive operation that will occur frequently when filling
  * the array with large amounts of data.  Adding new data to the linked list is
  * very inexpensive.
  */
+template <class T, s32 N = 0>
+class WoopsiArray;
+
+/**
+ * Dynamic array without inline storage.  All of the array functionality is
+ * implemented here; arrays with inline storage extend this class.
+ */
 template <class T>
-class WoopsiArray {
+class WoopsiArray<T, 0> {
 public:
 
 	/**
@@ -28,23 +56,80 @@ public:
 	 */
 	inline WoopsiArray(s32 initialReservedSize = 0);
 
+	/**
+	 * Copy constructor.
+	 * @param array The array to copy.
+	 */
+	WoopsiArray(const WoopsiArray<T>& array);
+
+#if __cplusplus >= 201103L
+
+	/**
+	 * Move constructor.  Takes the contents of the other array, leaving it
+	 * empty.
+	 * @param array The array to move.
+	 */
+	WoopsiArray(WoopsiArray<T>&& array);
+
+#endif
+
 	/**
 	 * Destructor.
 	 */
 	inline ~WoopsiArray();
 
+	/**
+	 * Assignment operator.
+	 * @param array The array to copy.
+	 * @return A reference to this array.
+	 */
+	WoopsiArray<T>& operator=(const WoopsiArray<T>& array);
+
+#if __cplusplus >= 201103L
+
+	/**
+	 * Move assignment operator.  Exchanges the contents of the two arrays.
+	 * @param array The array to move.
+	 * @return A reference to this array.
+	 */
+	WoopsiArray<T>& operator=(WoopsiArray<T>&& array);
+
+#endif
+
 	/**
 	 * Get the size of the array.
 	 * @return The size of the array.
 	 */
 	inline const s32 size() const;
 
+	/**
+	 * Get the number of values the array can hold before it needs to
+	 * allocate more memory.
+	 * @return The capacity of the array.
+	 */
+	inline const s32 capacity() const;
+
+	/**
+	 * Ensure that the array can hold at least the specified number of values
+	 * without allocating more memory.
+	 * @param size The number of values to reserve space for.
+	 */
+	void reserve(const s32 size);
+
 	/**
 	 * Add a value to the end of the array.
 	 * @param value The value to add to the array.
 	 */
 	void push_back(const T &value);
 
+	/**
+	 * Add several values to the end of the array.
+	 * @param values The values to add to the array.  Must not point into
+	 * this array.
+	 * @param count The number of values to add.
+	 */
+	void append(const T* values, const s32 count);
+
 	/**
 	 * Insert a value into the array.
 	 * @param index The index to insert into.
@@ -52,6 +137,14 @@ public:
 	 */
 	void insert(const s32 index, const T &value);
 
+	/**
+	 * Insert several values into the array.
+	 * @param index The index to insert into.
+	 * @param values The values to insert.  Must not point into this array.
+	 * @param count The number of values to insert.
+	 */
+	void insert(const s32 index, const T* values, const s32 count);
+
 	/**
 	 * Remove the last element from the array.
 	 */
@@ -62,6 +155,21 @@ public:
 	 */
 	void erase(const s32 index);
 
+	/**
+	 * Erase several consecutive values.
+	 * @param index The index of the first value to erase.
+	 * @param count The number of values to erase.
+	 */
+	void erase(const s32 index, s32 count);
+
+	/**
+	 * Exchange the contents of this array with another.  If neither array is
+	 * using inline storage this just swaps the arrays' pointers; otherwise
+	 * the values are exchanged one at a time.
+	 * @param array The array to swap with.
+	 */
+	void swap(WoopsiArray<T>& array);
+
 	/**
 	 * Get a value at the specified location.  Does not perform bounds checking.
 	 * @param index The index of the desired value.
@@ -87,36 +195,169 @@ public:
 	 */
 	T& operator[](const s32 index) const;
 
+protected:
+
+	/**
+	 * Constructor for arrays with inline storage.
+	 * @param buffer The inline storage.
+	 * @param bufferSize The number of values that fit in the inline storage.
+	 */
+	inline WoopsiArray(T* buffer, s32 bufferSize);
+
 private:
 	T* _data;								/**< Internal array of data items */
 	s32 _size;								/**< Number of items in the array */
 	s32 _reservedSize;						/**< Total size of the array including unpopulated slots */
+	T* _buffer;								/**< Inline storage, or NULL if there is none */
+
+	/**
+	 * Check if the array's data is held in its inline storage.
+	 * @return True if the data is held in the inline storage.
+	 */
+	inline bool isInline() const { return (_buffer != NULL) && (_data == _buffer); };
 
 	/**
-	 * Resize the array if it is full.  The array will double its capacity.
+	 * Resize the array if it does not have room for the specified number of
+	 * additional values.  The array will at least double its capacity.
+	 * @param count The number of values that need to fit.
 	 */
-	void resize();
+	void resize(const s32 count = 1);
+
+	/**
+	 * Move the array's data into a new block of memory.
+	 * @param newSize The capacity of the new block.
+	 */
+	void reallocate(const s32 newSize);
+
+	/**
+	 * Copy values between two blocks of memory that may overlap.
+	 * @param dest The destination.
+	 * @param source The source.
+	 * @param count The number of values to copy.
+	 */
+	static void move(T* dest, const T* source, const s32 count);
+};
+
+/**
+ * Dynamic array that can hold N values before it allocates memory from the
+ * heap.
+ */
+template <class T, s32 N>
+class WoopsiArray : public WoopsiArray<T, 0> {
+public:
+
+	/**
+	 * Constructor.
+	 */
+	inline WoopsiArray() : WoopsiArray<T, 0>(_items, N) { };
+
+	/**
+	 * Copy constructor.
+	 * @param array The array to copy.
+	 */
+	inline WoopsiArray(const WoopsiArray<T, N>& array) : WoopsiArray<T, 0>(_items, N) {
+		WoopsiArray<T, 0>::operator=(array);
+	};
+
+	/**
+	 * Assignment operator.
+	 * @param array The array to copy.
+	 * @return A reference to this array.
+	 */
+	inline WoopsiArray<T, N>& operator=(const WoopsiArray<T, N>& array) {
+		WoopsiArray<T, 0>::operator=(array);
+		return *this;
+	};
+
+private:
+	T _items[N];							/**< Inline storage */
 };
 
 template <class T>
-WoopsiArray<T>::WoopsiArray(s32 initialReservedSize) {
+WoopsiArray<T, 0>::WoopsiArray(s32 initialReservedSize) {
 	_size = 0;
-	_reservedSize = initialReservedSize > 0 ? initialReservedSize : DYNAMIC_ARRAY_SIZE;
-	_data = new T[_reservedSize];
+	_reservedSize = 0;
+	_data = NULL;
+	_buffer = NULL;
+
+	if (initialReservedSize > 0) reallocate(initialReservedSize);
 }
 
 template <class T>
-WoopsiArray<T>::~WoopsiArray() {
-	delete [] _data;
+WoopsiArray<T, 0>::WoopsiArray(T* buffer, s32 bufferSize) {
+	_size = 0;
+	_reservedSize = bufferSize;
+	_data = buffer;
+	_buffer = buffer;
 }
 
 template <class T>
-const s32 WoopsiArray<T>::size() const {
+WoopsiArray<T, 0>::WoopsiArray(const WoopsiArray<T>& array) {
+	_size = 0;
+	_reservedSize = 0;
+	_data = NULL;
+	_buffer = NULL;
+
+	append(array._data, array._size);
+}
+
+#if __cplusplus >= 201103L
+
+template <class T>
+WoopsiArray<T, 0>::WoopsiArray(WoopsiArray<T>&& array) {
+	_size = 0;
+	_reservedSize = 0;
+	_data = NULL;
+	_buffer = NULL;
+
+	swap(array);
+}
+
+#endif
+
+template <class T>
+WoopsiArray<T, 0>::~WoopsiArray() {
+	if (!isInline()) delete [] _data;
+}
+
+template <class T>
+WoopsiArray<T>& WoopsiArray<T, 0>::operator=(const WoopsiArray<T>& array) {
+	if (&array == this) return *this;
+
+	_size = 0;
+	append(array._data, array._size);
+
+	return *this;
+}
+
+#if __cplusplus >= 201103L
+
+template <class T>
+WoopsiArray<T>& WoopsiArray<T, 0>::operator=(WoopsiArray<T>&& array) {
+	swap(array);
+
+	return *this;
+}
+
+#endif
+
+template <class T>
+const s32 WoopsiArray<T, 0>::size() const {
 	return _size;
 }
 
 template <class T>
-void WoopsiArray<T>::push_back(const T &value) {
+const s32 WoopsiArray<T, 0>::capacity() const {
+	return _reservedSize;
+}
+
+template <class T>
+void WoopsiArray<T, 0>::reserve(const s32 size) {
+	if (size > _reservedSize) reallocate(size);
+}
+
+template <class T>
+void WoopsiArray<T, 0>::push_back(const T &value) {
 
 	// Ensure the array is large enough to contain this data
 	resize();
@@ -129,7 +370,20 @@ void WoopsiArray<T>::push_back(const T &value) {
 }
 
 template <class T>
-void WoopsiArray<T>::pop_back() {
+void WoopsiArray<T, 0>::append(const T* values, const s32 count) {
+
+	if (count < 1) return;
+
+	// Grow the array once rather than once per value
+	resize(count);
+
+	move(_data + _size, values, count);
+
+	_size += count;
+}
+
+template <class T>
+void WoopsiArray<T, 0>::pop_back() {
 	if (_size >= 1) {
 		// We can just reduce the used size of the array, as the value
 		// will get overwritten automatically
@@ -138,7 +392,7 @@ void WoopsiArray<T>::pop_back() {
 }
 
 template <class T>
-void WoopsiArray<T>::insert(const s32 index, const T &value) {
+void WoopsiArray<T, 0>::insert(const s32 index, const T &value) {
 
 	// Bounds check
 	if ((index >= _size) || (_size == 0)) {
@@ -150,9 +404,7 @@ void WoopsiArray<T>::insert(const s32 index, const T &value) {
 	resize();
 
 	// Shift all of the data back one place to make a space for the new data
-	for (s32 i = _size; i > index; i--) {
-		_data[i] = _data[i - 1];
-	}
+	move(_data + index + 1, _data + index, _size - index);
 
 	// Add data to array
 	_data[index] = value;
@@ -162,64 +414,151 @@ void WoopsiArray<T>::insert(const s32 index, const T &value) {
 }
 
 template <class T>
-void WoopsiArray<T>::erase(const s32 index) {
+void WoopsiArray<T, 0>::insert(const s32 index, const T* values, const s32 count) {
+
+	if (count < 1) return;
+
+	// Bounds check
+	if (index >= _size) {
+		append(values, count);
+		return;
+	}
+
+	// Grow the array once rather than once per value
+	resize(count);
+
+	// Shift the data back to make space for the new values
+	move(_data + index + count, _data + index, _size - index);
+	move(_data + index, values, count);
+
+	_size += count;
+}
+
+template <class T>
+void WoopsiArray<T, 0>::erase(const s32 index) {
+	erase(index, 1);
+}
+
+template <class T>
+void WoopsiArray<T, 0>::erase(const s32 index, s32 count) {
 
 	// Bounds check
 	if (index >= _size) return;
 
-	// Shift all of the data back one place and overwrite the value
-	for (s32 i = index; i < _size - 1; i++) {
-		_data[i] = _data[i + 1];
+	if (index + count > _size) count = _size - index;
+
+	if (count < 1) return;
+
+	// Shift all of the data back over the erased values
+	move(_data + index, _data + index + count, _size - index - count);
+
+	// Remember we've removed the slots
+	_size -= count;
+}
+
+template <class T>
+void WoopsiArray<T, 0>::swap(WoopsiArray<T>& array) {
+
+	if (&array == this) return;
+
+	if (!isInline() && !array.isInline()) {
+
+		// Neither array is using inline storage so we can swap pointers
+		T* data = _data;
+		s32 reservedSize = _reservedSize;
+
+		_data = array._data;
+		_reservedSize = array._reservedSize;
+
+		array._data = data;
+		array._reservedSize = reservedSize;
+	} else {
+
+		// Ensure that both arrays have room for the other's values, then
+		// exchange the values one at a time
+		reserve(array._size);
+		array.reserve(_size);
+
+		s32 count = _size > array._size ? _size : array._size;
+
+		for (s32 i = 0; i < count; i++) {
+			T value = _data[i];
+			_data[i] = array._data[i];
+			array._data[i] = value;
+		}
 	}
 
-	// Remember we've removed a slot
-	_size--;
+	s32 size = _size;
+	_size = array._size;
+	array._size = size;
 }
 
 template <class T>
-void WoopsiArray<T>::resize() {
+void WoopsiArray<T, 0>::resize(const s32 count) {
 	// Do we need to redim the array?
-	if (_reservedSize == _size) {
-		
-		// We have filled the array, so resize it
+	if (_size + count > _reservedSize) {
 
-		// Create new array
-		u32 newSize = _reservedSize * 2;
-		T* newData = new T[newSize];
+		// We have filled the array, so double its size
+		s32 newSize = _reservedSize > 0 ? _reservedSize * 2 : DYNAMIC_ARRAY_SIZE;
 
-		// Copy old array to new
-		for (s32 i = 0; i < _reservedSize; i++) {
-			newData[i] = _data[i];
-		}
+		if (newSize < _size + count) newSize = _size + count;
+
+		reallocate(newSize);
+	}
+}
 
-		//memcpy(newData, _data, sizeof(T) * _reservedSize);
+template <class T>
+void WoopsiArray<T, 0>::reallocate(const s32 newSize) {
+
+	// Create new array
+	T* newData = new T[newSize];
+
+	// Copy old array to new
+	move(newData, _data, _size);
+
+	// Delete the old array
+	if (!isInline()) delete [] _data;
+
+	// Update values
+	_data = newData;
+	_reservedSize = newSize;
+}
+
+template <class T>
+void WoopsiArray<T, 0>::move(T* dest, const T* source, const s32 count) {
 
-		// Delete the old array
-		delete [] _data;
+	if (count < 1) return;
 
-		// Update values
-		_data = newData;
-		_reservedSize = newSize;
+	if (WOOPSI_ARRAY_IS_TRIVIAL(T)) {
+		memmove((void*)dest, (const void*)source, sizeof(T) * count);
+	} else if (dest < source) {
+		for (s32 i = 0; i < count; i++) {
+			dest[i] = source[i];
+		}
+	} else {
+		for (s32 i = count - 1; i >= 0; i--) {
+			dest[i] = source[i];
+		}
 	}
 }
 
 template <class T>
-T& WoopsiArray<T>::at(const s32 index) const {
+T& WoopsiArray<T, 0>::at(const s32 index) const {
 	return _data[index];
 }
 
 template <class T>
-bool WoopsiArray<T>::empty() const {
+bool WoopsiArray<T, 0>::empty() const {
 	return (_size == 0);
 }
 
 template <class T>
-T& WoopsiArray<T>::operator[](const s32 index) const {
+T& WoopsiArray<T, 0>::operator[](const s32 index) const {
 	return _data[index];
 }
 
 template <class T>
-void WoopsiArray<T>::clear() {
+void WoopsiArray<T, 0>::clear() {
 	// All we need to do is reset the size value
 	_size = 0;
 }
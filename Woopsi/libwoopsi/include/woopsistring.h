@@ -5,6 +5,16 @@
 #include <nds.h>
 #include "woopsiarray.h"
 
+/**
+ * Number of characters between each entry in a WoopsiString's token index.
+ */
+const s32 WOOPSI_STRING_INDEX_INTERVAL = 32;
+
+/**
+ * Number of bytes that a WoopsiString can store without allocating memory.
+ */
+const s32 WOOPSI_STRING_INLINE_SIZE = 16;
+
 namespace WoopsiUI {
 	
 	class StringIterator;
@@ -21,13 +31,24 @@ namespace WoopsiUI {
 	 * means that increasing the length of such a string is a cheaper operation
 	 * as memory does not need to allocated and copied.
 	 *
-	 * Additionally, the string increases its array size by _growAmount every
-	 * time it needs to allocate extra memory, potentially reducing the number
-	 * of reallocs needed.
+	 * Strings of up to WOOPSI_STRING_INLINE_SIZE bytes are stored within the
+	 * object itself and do not allocate any memory.  Longer strings at least
+	 * double their array size every time they need to allocate extra memory,
+	 * so building a string by repeatedly appending to it needs only a
+	 * logarithmic number of reallocs.  Use reserve() to allocate enough
+	 * memory up front if the final size is known.
 	 *
 	 * The string is not null-terminated.  Instead, it uses a _stringLength
 	 * member that stores the number of characters in the string.  This saves a
 	 * byte and makes calls to getLength() run in O(1) time instead of O(n).
+	 *
+	 * Strings that contain only ASCII characters store one byte per character
+	 * so characters can be located directly.  Strings that contain multi-byte
+	 * characters build an index of the position of every
+	 * WOOPSI_STRING_INDEX_INTERVAL'th character the first time a character
+	 * is located by its index.  Random access is therefore O(1) rather than
+	 * O(n).  Modifying the string discards the part of the index that follows
+	 * the modification.
 	 */
 	class WoopsiString {
 	public:
@@ -56,6 +77,17 @@ namespace WoopsiUI {
 		 */
 		WoopsiString(const WoopsiString& string);
 
+#if __cplusplus >= 201103L
+
+		/**
+		 * Move constructor.  Takes ownership of the supplied string's memory
+		 * and leaves the supplied string empty.
+		 * @param string WoopsiString object to move.
+		 */
+		WoopsiString(WoopsiString&& string);
+
+#endif
+
 		/**
 		 * Constructor that creates a copy of the supplied string from
 		 * startIndex onwards (ie. it creates a substring).
@@ -77,14 +109,19 @@ namespace WoopsiUI {
 		 * Destructor.
 		 */
 		virtual inline ~WoopsiString() {
-			delete[] _text;
+			if (_text != _inlineText) delete[] _text;
 			_text = NULL;
+
+			delete _tokenIndex;
+			_tokenIndex = NULL;
 		};
 		
 		/**
 		 * Creates and returns a new StringIterator object that will iterate
 		 * over this string.  The object must be manually deleted once it is
-		 * no longer needed.
+		 * no longer needed.  Code that only needs an iterator for the duration
+		 * of a function should create a StringIterator on the stack instead,
+		 * which avoids the heap allocation.
 		 * @return A new StringIterator object.
 		 */
 		StringIterator* newStringIterator() const;
@@ -132,6 +169,20 @@ namespace WoopsiUI {
 		 */
 		virtual void append(const WoopsiString& text);
 
+		/**
+		 * Ensure that the string has enough memory to hold the specified
+		 * number of bytes without needing to allocate more.
+		 * @param bytes The number of bytes to reserve.
+		 */
+		void reserve(const s32 bytes);
+
+		/**
+		 * Swap the contents of this string with another string.  Strings
+		 * stored on the heap are swapped without copying their data.
+		 * @param string The string to swap with.
+		 */
+		void swap(WoopsiString& string);
+
 		/**
 		 * Insert text at the specified character index.
 		 * @param text The text to insert.
@@ -165,12 +216,17 @@ namespace WoopsiUI {
 		 */
 		virtual const s32 getByteCount() const { return _dataLength; };
 
+		/**
+		 * Check if the string contains only ASCII characters.  Each character
+		 * in an ASCII string occupies a single byte.
+		 * @return True if the string contains only ASCII characters.
+		 */
+		inline bool isAscii() const { return _dataLength == _stringLength; };
+
 		/**
 		 * Get the character at the specified index.  This function is useful
 		 * for finding the occasional character at an index, but for iterating
-		 * over strings it is exceptionally slow.  The newStringIterator()
-		 * method should be used to retrieve an iterator object that can iterate
-		 * over the string efficiently.
+		 * over strings a StringIterator is more efficient.
 		 * @param index The index of the character to retrieve.
 		 * @return The character at the specified index.
 		 */
@@ -260,6 +316,18 @@ namespace WoopsiUI {
 		 */
 		WoopsiString& operator=(const WoopsiString& string);
 
+#if __cplusplus >= 201103L
+
+		/**
+		 * Move assignment operator.  Takes ownership of the supplied string's
+		 * memory.
+		 * @param string The string to move.
+		 * @return This string.
+		 */
+		WoopsiString& operator=(WoopsiString&& string);
+
+#endif
+
 		/**
 		 * Overloaded assignment operator.  Copies the data within the argument
 		 * char array to this string.
@@ -479,7 +547,8 @@ namespace WoopsiUI {
 		virtual void init();
 
 		/**
-		 * Allocate memory for the string.
+		 * Allocate memory for the string.  If more memory is needed the
+		 * allocated size at least doubles.
 		 * @param chars Number of chars to allocate.
 		 * @param preserve If true, the data in the existing memory will be
 		 * preserved if new memory must be allocated
@@ -539,20 +608,29 @@ namespace WoopsiUI {
 		s32 _dataLength;	/**< Length of char data in the string */
 		s32 _stringLength;	/**< Number of unicode tokens in the string */
 		s32 _allocatedSize;	/**< Number of bytes allocated for this string */
-		s32 _growAmount;	/**< Number of chars that the string grows by
-								 whenever it needs to get larger */
+		char _inlineText[WOOPSI_STRING_INLINE_SIZE];	/**< Storage used for
+														 short strings */
+		mutable WoopsiArray<s32>* _tokenIndex;	/**< Byte offset of every
+												 WOOPSI_STRING_INDEX_INTERVAL'th
+												 token; built on demand */
+
+		/**
+		 * Discard any entries in the token index that may be invalidated by
+		 * a change to the string at the specified character index.
+		 * @param index Index of the first character that has changed.
+		 */
+		void truncateTokenIndex(const s32 index);
 									 
 		/**
-		 * Encodes a codepoint into its UTF-8 representation.  Will allocate
-		 * a block of memory if the encode is successful containing the encoded
-		 * data.  This memory must be deleted with delete[] when it is no longer
-		 * needed to avoid a memory leak.  If the codepoint is not valid, the
-		 * method will return NULL.
+		 * Encodes a codepoint into its UTF-8 representation.  If the
+		 * codepoint is not valid, the method will return 0 and the buffer
+		 * will not be altered.
 		 * @param codePoint Codepoint to encode.
-		 * @param numBytes The number of bytes in the encoded data.
-		 * @return The encoded codepoint.
+		 * @param buffer Buffer of at least 4 bytes that will hold the encoded
+		 * data.
+		 * @return The number of bytes in the encoded data.
 		 */
-		 const char* encodeCodePoint(u32 codePoint, u8* numBytes = NULL) const;
+		 u8 encodeCodePoint(u32 codePoint, char* buffer) const;
 	};
 }
 
@@ -3,6 +3,7 @@
 
 #include <nds.h>
 #include "gadget.h"
+#include "timerwheel.h"
 #include "woopsi.h"
 
 namespace WoopsiUI {
@@ -19,8 +20,13 @@ namespace WoopsiUI {
 	 *  - Catch the timer's action event and call any code that should run.
 	 *
 	 * The maximum speed for timer-driven code is one iteration per vertical blank.  
+	 *
+	 * The timer is a thin wrapper around a TimerHandle scheduled on Woopsi's
+	 * TimerWheel, so a timer costs nothing on the VBLs on which it does not
+	 * fire.  Code that does not need a gadget can subclass TimerHandle
+	 * directly.
 	 */
-	class WoopsiTimer : public Gadget {
+	class WoopsiTimer : public Gadget, public TimerHandle {
 	public:
 
 		/**
@@ -42,42 +48,33 @@ namespace WoopsiUI {
 		 * last event fired.
 		 * @return Frame count since the last event fired.
 		 */
-		inline const u32 getFrameCount() const { return _frameCount; };
+		const u32 getFrameCount() const;
 
 		/**
 		 * Resets the frame count back to 0.
 		 */
-		inline void reset() { _frameCount = 0; };
+		void reset();
 
 		/**
 		 * Starts the timer.
 		 */
-		inline void start() { _isRunning = true; };
+		void start();
 
 		/**
 		 * Stops the timer and resets the frame count.
 		 */
-		inline void stop() {
-			_isRunning = false;
-			_frameCount = 0;
-		};
+		void stop();
 
 		/**
 		 * Stops the timer but does not reset the frame count.
 		 */
-		inline void pause() { _isRunning = false; }
+		void pause();
 
 		/**
 		 * Set the timeout of this timer.
 		 * @param timeout The number of frames that this timer will run before firing an event.
 		 */
-		inline void setTimeout(u32 timeout) { _timeout = timeout; };
-
-		/**
-		 * Run any code that should execute every VBL.
-		 * @return True if the function ran succesfully.
-		 */
-		virtual bool run();
+		void setTimeout(u32 timeout);
 
 		/**
 		 * Check if the timer is running or not.
@@ -86,26 +83,33 @@ namespace WoopsiUI {
 		inline bool isRunning() { return _isRunning; };
 
 	protected:
-		u32 _frameCount;			/**< Number of frames run so far */
+		u32 _frameCount;			/**< Number of frames run before the timer was last paused */
+		u32 _startTime;				/**< Wheel time at which the current frame count began */
 		u32 _timeout;				/**< Number of frames to run before firing an event */
 		bool _isRunning;			/**< Indicates whether or not the timer is running */
 		bool _isRepeater;			/**< Indicates whether or not the timer repeats */
 
 		/**
-		 * Destructor.
+		 * Called by the timer wheel when the timeout expires.  Re-arms the
+		 * timer if it repeats and raises an action event.
 		 */
-		virtual inline ~WoopsiTimer() {
-			if (woopsiApplication != NULL) {
+		virtual void onTimerExpired();
 
-				// Prevent gadget from receiving VBLs
-				woopsiApplication->unregisterFromVBL(this);
-			}
-		};
+		/**
+		 * Schedule the timer to expire once the remainder of the timeout has
+		 * elapsed.
+		 */
+		void arm();
+
+		/**
+		 * Destructor.
+		 */
+		virtual inline ~WoopsiTimer() { };
 
 		/**
 		 * Copy constructor is protected to prevent usage.
 		 */
-		inline WoopsiTimer(const WoopsiTimer& woopsiTimer) : Gadget(woopsiTimer) { };
+		inline WoopsiTimer(const WoopsiTimer& woopsiTimer) : Gadget(woopsiTimer), TimerHandle() { };
 	};
 }
 
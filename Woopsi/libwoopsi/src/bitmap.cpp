@@ -12,6 +12,8 @@ Bitmap::Bitmap(u16 width, u16 height) {
 
 	// Allocate memory for bitmap
 	_bitmap = new u16[_width * _height];
+
+	clearDirtyRect();
 }
 
 Bitmap::Bitmap(const BitmapBase& bitmap) {
@@ -23,6 +25,8 @@ Bitmap::Bitmap(const BitmapBase& bitmap) {
 
 	// Tell the other bitmap to copy its data into the current bitmap
 	bitmap.copy(0, 0, _width * _height, _bitmap);
+
+	clearDirtyRect();
 }
 
 // Get a single pixel from the bitmap
@@ -47,6 +51,8 @@ void Bitmap::setPixel(s16 x, s16 y, u16 colour) {
 	// Plot the pixel
 	u32 pos = (y * _width) + x;
 	_bitmap[pos] = colour;
+
+	markDirty(x, y, x + 1, y + 1);
 }
 
 const u16* Bitmap::getData(s16 x, s16 y) const {
@@ -71,12 +77,32 @@ Graphics* Bitmap::newGraphics() {
 
 void Bitmap::blit(const s16 x, const s16 y, const u16* data, const u32 size) {
 	u16* pos = _bitmap + (y * _width) + x;
-	woopsiDmaCopy(data, pos, size);
+	woopsiDmaMove(data, pos, size);
+
+	markDirtyRun(x, y, size);
 }
 
 void Bitmap::blitFill(const s16 x, const s16 y, const u16 colour, const u32 size) {
 	u16* pos = _bitmap + (y * _width) + x;
 	woopsiDmaFill(colour, pos, size);
+
+	markDirtyRun(x, y, size);
+}
+
+void Bitmap::fillRect(s16 x, s16 y, u16 width, u16 height, const u16 colour) {
+	Rect rect;
+	if (!clipToBitmap(_width, _height, x, y, width, height, rect)) return;
+
+	markDirty(rect.x, rect.y, rect.x + rect.width, rect.y + rect.height);
+	fillData(_bitmap, _width, rect, colour);
+}
+
+void Bitmap::xorRect(s16 x, s16 y, u16 width, u16 height, const u16 colour) {
+	Rect rect;
+	if (!clipToBitmap(_width, _height, x, y, width, height, rect)) return;
+
+	markDirty(rect.x, rect.y, rect.x + rect.width, rect.y + rect.height);
+	xorData(_bitmap, _width, rect, colour);
 }
 
 void Bitmap::copy(s16 x, s16 y, u32 size, u16* dest) const {
@@ -101,4 +127,9 @@ void Bitmap::setDimensions(u16 width, u16 height) {
 	_bitmap = newBitmap;
 	_width = width;
 	_height = height;
+
+	// Anything outside the copied area is undefined, so treat the whole
+	// bitmap as changed
+	clearDirtyRect();
+	markDirty(0, 0, width, height);
 }
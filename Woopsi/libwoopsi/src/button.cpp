@@ -9,6 +9,7 @@ Button::Button(s16 x, s16 y, u16 width, u16 height, const WoopsiString& text, Ga
 }
 
 void Button::drawContents(GraphicsPort* port) {
+	validateTextPosition();
 
 	u16 textColour;
 
@@ -20,7 +21,7 @@ void Button::drawContents(GraphicsPort* port) {
 		textColour = getShineColour();
 	}
 
-	port->drawText(_textX, _textY, getFont(), _text, 0, _text.getLength(), textColour);
+	port->drawText(_textX, _textY, getFont(), _text, 0, _text.getLength(), textColour, getTextWidth());
 }
 
 void Button::drawBorder(GraphicsPort* port) {
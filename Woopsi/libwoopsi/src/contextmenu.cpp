@@ -78,6 +78,8 @@ void ContextMenu::reset() {
 	_rect.setY(0);
 	_rect.setWidth(0);
 	_rect.setHeight(0);
+
+	invalidateScreenRectCache();
 }
 
 // Get the preferred dimensions of the gadget
@@ -106,7 +106,7 @@ void CycleButton::drawContents(GraphicsPort* port) {
 
 	// Only draw text if option is selected
 	if (_options.getSelectedItem() != NULL) {
-		port->drawText(_textX, _textY, getFont(), _options.getSelectedItem()->getText(), 0, _options.getSelectedItem()->getText().getLength(), textColour);
+		port->drawText(_textX, _textY, getFont(), _options.getSelectedItem()->getText(), 0, _options.getSelectedItem()->getText().getLength(), textColour, _options.getSelectedItem()->getTextWidth(getFont()));
 	}
 }
 
@@ -184,7 +184,7 @@ void CycleButton::getPreferredDimensions(Rect& rect) const {
 
 	// Locate longest string in options
 	for (s32 i = 0; i < _options.getItemCount(); ++i) {
-		optionWidth = getFont()->getStringWidth(_options.getItem(i)->getText());
+		optionWidth = _options.getItem(i)->getTextWidth(getFont());
 
 		if (optionWidth > maxWidth) {
 			maxWidth = optionWidth;
@@ -1,7 +1,15 @@
 #include <nds.h>
 #include "dmafuncs.h"
 
-#ifndef USING_SDL
+#ifdef USING_SDL
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#else
 
 static const u32 MEM_VRAM_START = 0x06000000;
 static const u32 MEM_VRAM_END = 0x06400000;
@@ -56,6 +64,59 @@ void woopsiDmaFill(u16 fill, u16* dest, u32 count) {
 
 #ifdef USING_SDL
 
+    // SSE2 and NEON are part of the x86-64 and AArch64 baselines, so they
+    // are chosen when the library is compiled rather than at runtime
+#if defined(__SSE2__) || defined(__ARM_NEON)
+    const u32 BLOCK_SIZE = 16;
+#else
+    const u32 BLOCK_SIZE = 8;
+#endif
+
+    // Write single pixels until the destination is aligned to a block
+    while ((count > 0) && ((size_t)dest & (BLOCK_SIZE - 1))) {
+        *dest++ = fill;
+        --count;
+    }
+
+    u32 blocks = count / (BLOCK_SIZE / sizeof(u16));
+
+#if defined(__SSE2__)
+
+    __m128i fillBlock = _mm_set1_epi16((short)fill);
+
+    for (u32 i = 0; i < blocks; i++) {
+        _mm_store_si128((__m128i*)dest, fillBlock);
+        dest += BLOCK_SIZE / sizeof(u16);
+    }
+
+#elif defined(__ARM_NEON)
+
+    uint16x8_t fillBlock = vdupq_n_u16(fill);
+
+    for (u32 i = 0; i < blocks; i++) {
+        vst1q_u16(dest, fillBlock);
+        dest += BLOCK_SIZE / sizeof(u16);
+    }
+
+#else
+
+    // Widen to u32 before shifting so that the top bit of the colour does
+    // not overflow an int
+    u64 fillBlock = (u32)fill * 0x00010001u;
+    fillBlock |= fillBlock << 32;
+
+    // memcpy() keeps the store legal for u16 memory and compiles to a
+    // single 64-bit write
+    for (u32 i = 0; i < blocks; i++) {
+        memcpy(dest, &fillBlock, sizeof(fillBlock));
+        dest += BLOCK_SIZE / sizeof(u16);
+    }
+
+#endif
+
+    // Write the pixels that do not fill a whole block
+    count -= blocks * (BLOCK_SIZE / sizeof(u16));
+
     for (u32 i = 0; i < count; i++) {
         *(dest + i) = fill;
     }
@@ -93,4 +154,28 @@ void woopsiDmaFill(u16 fill, u16* dest, u32 count) {
 
 #endif
 
+}
+
+void woopsiDmaMove(const u16* source, u16* dest, u32 count) {
+
+#ifdef USING_SDL
+
+    memmove(dest, source, sizeof(u16) * count);
+
+#else
+
+    // A forward copy is safe unless the destination starts within the source
+    if ((dest <= source) || (dest >= source + count)) {
+        woopsiDmaCopy(source, dest, count);
+        return;
+    }
+
+    // Regions overlap with the destination after the source, so copy
+    // backwards to avoid overwriting data that has not yet been copied
+    for (u32 i = count; i > 0; i--) {
+        *(dest + i - 1) = *(source + i - 1);
+    }
+
+#endif
+
 }
\ No newline at end of file
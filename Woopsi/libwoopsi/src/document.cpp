@@ -7,6 +7,10 @@ Document::Document(FontBase* font, const WoopsiString& text, u16 width) {
 	_font = font;
 	_width = width;
 	_lineSpacing = 1;
+	_textPixelWidth = 0;
+	_textPixelHeight = 0;
+	_isLazy = false;
+	_isWrapped = false;
 	_text.setText(text);
 	wrap();
 }
@@ -17,7 +21,7 @@ FontBase* Document::getFont() const {
 
 // Calculate the length of an individual line
 const u8 Document::getLineLength(const s32 lineNumber) const {
-	if (lineNumber < getLineCount() - 1) {
+	if (lineNumber < getLineCount()) {
 		return _linePositions[lineNumber + 1] - _linePositions[lineNumber];
 	}
 	
@@ -29,17 +33,15 @@ const s16 Document::getLineTrimmedLength(const s32 lineNumber) const {
 	s16 length = getLineLength(lineNumber);
 	
 	// Loop through string until the end
-	StringIterator* iterator = _text.newStringIterator();
+	StringIterator iterator(&_text);
 	
 	// Get char at the end of the line
-	if (iterator->moveTo(_linePositions[lineNumber] + length - 1)) {
+	if (iterator.moveTo(_linePositions[lineNumber] + length - 1)) {
 		do{
-			if (!_font->isCharBlank(iterator->getCodePoint())) break;
+			if (!_font->isCharBlank(iterator.getCodePoint())) break;
 			length--;
-		} while (iterator->moveToPrevious() && (length > 0));
+		} while (iterator.moveToPrevious() && (length > 0));
 	}
-	
-	delete iterator;
 
 	return length;
 }
@@ -54,228 +56,363 @@ const s16 Document::getLineTrimmedPixelLength(const s32 lineNumber) const {
 
 void Document::setText(const WoopsiString& text) {
 	_text.setText(text);
-	wrap();
+	rewrap();
 }
 
 void Document::setText(const char* text) {
 	_text.setText(text);
-	wrap();
+	rewrap();
 }
 
 void Document::setText(const u32 text) {
 	_text.setText(text);
-	wrap();
+	rewrap();
 }
 
 void Document::append(const WoopsiString& text) {
+	s32 oldLength = _text.getLength();
+	s32 line = getEditLine(oldLength);
+
 	_text.append(text);
-	wrap(_text.getLength() - 1);
+
+	wrapFromLine(line, oldLength, _text.getLength() - oldLength);
 }
 
 void Document::insert(const WoopsiString& text, const s32 index) {
+	s32 oldLength = _text.getLength();
+
+	// Text inserted beyond the end of the string is appended
+	s32 editIndex = index < oldLength ? index : oldLength;
+	s32 line = getEditLine(editIndex);
+
 	_text.insert(text, index);
-	wrap(index);
+
+	wrapFromLine(line, editIndex, _text.getLength() - oldLength);
 }
 
 void Document::remove(const s32 startIndex) {
-	_text.remove(startIndex);
-	wrap(startIndex);
+	remove(startIndex, _text.getLength() - startIndex);
 }
 
 void Document::remove(const s32 startIndex, const s32 count) {
+	s32 oldLength = _text.getLength();
+	s32 line = getEditLine(startIndex);
+
 	_text.remove(startIndex, count);
-	wrap(startIndex);
+
+	// Nothing to do if no text was removed
+	s32 delta = _text.getLength() - oldLength;
+
+	if (delta == 0) return;
+
+	wrapFromLine(line, startIndex - delta, delta);
 }
 
 void Document::setLineSpacing(u8 lineSpacing) {
 	_lineSpacing = lineSpacing;
-	wrap();
+
+	// Line spacing does not affect wrapping
+	calculatePixelHeight();
 }
 
 void Document::setWidth(u16 width) {
 	_width = width;
-	wrap();
+	rewrap();
 }
 
 void Document::wrap() {
 	wrap(0);
 }
 
-void Document::wrap(s32 charIndex) {
-	
-	// Declare vars in advance of loop
-	s32 pos = 0;
-	s32 lineWidth;
-	s32 breakIndex;
-	bool endReached = false;
+void Document::rewrap() {
+
+	if (!_isLazy) {
+		wrap();
+		return;
+	}
+
+	// Discard everything and wrap the first few lines
+	_linePositions.clear();
+	_linePositions.push_back(0);
+	_lineWidths.clear();
+	_textPixelWidth = 0;
+	_isWrapped = false;
+
+	wrapLines(DOCUMENT_LAZY_WRAP_LINES);
+}
+
+void Document::setLazyWrapping(const bool isLazy) {
+	_isLazy = isLazy;
+
+	if ((!_isLazy) && (!_isWrapped)) wrap();
+}
+
+bool Document::wrapLines(const s32 lines) {
+
+	if (_isWrapped) return true;
+
+	s32 pos = _linePositions[_linePositions.size() - 1];
+	s32 lineWidth = 0;
+
+	for (s32 i = 0; i < lines; ++i) {
+		pos = wrapLine(pos, lineWidth);
+
+		if (pos == -1) {
+
+			// The final line runs to the end of the text
+			_lineWidths.push_back(0);
+			_linePositions.push_back(_text.getLength());
+			_isWrapped = true;
+			break;
+		}
+
+		_lineWidths.push_back(lineWidth);
+		_linePositions.push_back(pos);
+
+		if (lineWidth > _textPixelWidth) _textPixelWidth = lineWidth;
+	}
+
+	calculatePixelHeight();
+
+	return _isWrapped;
+}
+
+void Document::wrapToLine(const s32 line) {
+	if (line >= getLineCount()) wrapLines(line - getLineCount() + 1);
+}
+
+const s32 Document::getEstimatedLineCount() const {
+
+	if (_isWrapped) return getLineCount();
+
+	s32 lines = getLineCount();
+	s32 wrappedLength = _linePositions[lines];
+
+	if ((lines == 0) || (wrappedLength == 0)) return lines + 1;
+
+	// Assume that the rest of the text wraps into lines of the same average
+	// length as the lines wrapped so far
+	s32 lineLength = wrappedLength / lines;
+
+	if (lineLength == 0) lineLength = 1;
+
+	s32 remainingLines = (_text.getLength() - wrappedLength + lineLength - 1) / lineLength;
+
+	// The unwrapped text always contains at least one line, even if it is
+	// empty
+	if (remainingLines == 0) remainingLines = 1;
+
+	return lines + remainingLines;
+}
+
+void Document::calculatePixelHeight() {
+
+	// Calculate the total height of the text
+	_textPixelHeight = getEstimatedLineCount() * (_font->getHeight() + _lineSpacing);
 	
-	if (_linePositions.size() == 0) charIndex = 0;
+	// Ensure height is always at least one row
+	if (_textPixelHeight == 0) _textPixelHeight = _font->getHeight() + _lineSpacing;
+}
+
+void Document::wrap(s32 charIndex) {
 	
-	// If we're wrapping from an offset in the text, ensure that any existing
-	// data after the offset gets removed
-	if (charIndex > 0) {
-		
-		// Remove wrapping data past this point
-		
-		// Get the index of the line in which the char index appears
-		s32 lineIndex = getLineContainingCharIndex(charIndex);
-		
-		// Remove any longest line records that occur from the line index
-		// onwards
-		while ((_longestLines.size() > 0) && (_longestLines[_longestLines.size() - 1].index >= lineIndex)) {
-			_longestLines.pop_back();
+	s32 line = 0;
+
+	// Rewrap from the line containing the char index if we have existing
+	// wrapping data
+	if ((charIndex > 0) && (_linePositions.size() > 0)) {
+		line = getLineContainingCharIndex(charIndex);
+	}
+
+	wrapFromLine(line, -1, 0);
+}
+
+void Document::wrapFromLine(const s32 line, const s32 syncIndex, const s32 delta) {
+
+	if (_linePositions.size() == 0) {
+		_linePositions.push_back(0);
+	}
+
+	WoopsiArray<s32> positions;
+	WoopsiArray<u8> widths;
+
+	s32 pos = _linePositions[line];
+	s32 lineWidth = 0;
+	s32 oldLine = line + 1;
+	s32 syncLine = -1;
+	s32 linesAfterEdit = 0;
+	bool isDeferred = false;
+
+	// If the text is fully wrapped the last position is the end of the text
+	// rather than the start of a line, so it cannot be synced with
+	s32 syncLimit = _isWrapped ? _linePositions.size() - 1 : _linePositions.size();
+
+	// Find where the end of the wrapped text has moved to
+	s32 wrappedLength = _linePositions[_linePositions.size() - 1];
+
+	if (syncIndex > -1) {
+		if (wrappedLength >= syncIndex) {
+			wrappedLength += delta;
+		} else if (wrappedLength > syncIndex + delta) {
+			wrappedLength = syncIndex + delta;
 		}
-		
-		// If there are any longest line records remaining, update the text
-		// pixel width.  The last longest line record will always be the last
-		// valid longest line as the vector is sorted by length
-		if (_longestLines.size() > 0) {
-			_textPixelWidth = _longestLines[_longestLines.size() - 1].width;
-		} else {
-			_textPixelWidth = 0;
+	}
+
+	// Loop through string until the end
+	while ((pos = wrapLine(pos, lineWidth)) > -1) {
+		widths.push_back(lineWidth);
+
+		if (syncIndex > -1) {
+
+			// Wrapping a line depends only on the text that follows its
+			// start, so once a line starts at the same place in the unchanged
+			// text as an existing line, all subsequent lines are unchanged
+			while ((oldLine < syncLimit) && (_linePositions[oldLine] + delta < pos)) {
+				oldLine++;
+			}
+
+			if ((oldLine < syncLimit) && (_linePositions[oldLine] >= syncIndex) && (_linePositions[oldLine] + delta == pos)) {
+				syncLine = oldLine;
+				break;
+			}
 		}
-		
-		// Remove any wrapping data from after this line index onwards
-		while ((_linePositions.size() > 0) && (_linePositions.size() - 1 > (s32)lineIndex)) {
-			_linePositions.pop_back();
+
+		positions.push_back(pos);
+
+		// Leave the rest of a lazily-wrapped document for later once we
+		// pass the end of the wrapped text or have wrapped enough lines
+		// after the edit
+		if (_isLazy && (syncIndex > -1)) {
+			if (pos > syncIndex + delta) linesAfterEdit++;
+
+			if (((!_isWrapped) && (pos >= wrappedLength)) || (linesAfterEdit >= DOCUMENT_LAZY_WRAP_LINES)) {
+				isDeferred = true;
+				break;
+			}
 		}
-		
-		// Adjust start position of wrapping loop so that it starts with the
-		// current line index
-		if (_linePositions.size() > 0) {
-			pos = _linePositions[_linePositions.size() - 1];
+	}
+
+	if (isDeferred) {
+		syncLine = _linePositions.size();
+		_isWrapped = false;
+	} else if (syncLine == -1) {
+
+		// The final line runs to the end of the text; its width is not used
+		// when calculating the width of the text
+		widths.push_back(0);
+		positions.push_back(_text.getLength());
+
+		syncLine = _linePositions.size();
+		_isWrapped = true;
+	}
+
+	// Work out if the widest line is being replaced
+	u8 replacedWidth = 0;
+
+	for (s32 i = line; i < syncLine && i < _lineWidths.size(); ++i) {
+		if (_lineWidths[i] > replacedWidth) replacedWidth = _lineWidths[i];
+	}
+
+	// Replace the old wrapping data with the new
+	_linePositions.erase(line + 1, syncLine - line - 1);
+	if (positions.size() > 0) _linePositions.insert(line + 1, &positions[0], positions.size());
+
+	_lineWidths.erase(line, syncLine - line);
+	_lineWidths.insert(line, &widths[0], widths.size());
+
+	// Shift the unchanged lines to account for the change in length
+	if (delta != 0) {
+		for (s32 i = line + 1 + positions.size(); i < _linePositions.size(); ++i) {
+			_linePositions[i] += delta;
+		}
+	}
+
+	// Update the width of the text
+	if (replacedWidth < _textPixelWidth) {
+
+		// The widest line is unchanged, although a new line may be wider
+		for (s32 i = 0; i < widths.size(); ++i) {
+			if (widths[i] > _textPixelWidth) _textPixelWidth = widths[i];
 		}
 	} else {
-		
-		// Remove all wrapping data
-		
-		// Wipe the width variable
 		_textPixelWidth = 0;
+
+		for (s32 i = 0; i < _lineWidths.size(); ++i) {
+			if (_lineWidths[i] > _textPixelWidth) _textPixelWidth = _lineWidths[i];
+		}
+	}
+
+	calculatePixelHeight();
+}
+
+s32 Document::wrapLine(s32 pos, s32& lineWidth) const {
+
+	s32 remaining = _text.getLength() - pos;
+
+	lineWidth = 0;
+
+	if (remaining < 1) return -1;
+
+	// Find line breaks and valid breakpoints until we exceed the width of
+	// the text field or we run out of string to process
+	FontBase::TextRun run;
+	_font->measureRun(_text, pos, remaining, _width, run);
+
+	lineWidth = run.width;
+
+	// If the whole of the remaining text fits the line runs to the end of
+	// the string
+	if ((run.length == remaining) && (!run.isNewline)) return -1;
+
+	// Index of the line return or of the first char that did not fit
+	s32 endIndex = run.isNewline ? pos + run.length - 1 : pos + run.length;
+
+	if (endIndex > pos) {
 		
-		// Empty existing longest lines
-		_longestLines.clear();
-		
-		// Empty existing line positions
-		_linePositions.clear();
+		// If we didn't find a breakpoint split at the current position
+		s32 breakIndex = run.breakIndex > 0 ? run.breakIndex : endIndex - 1;
 		
-		// Push first line start into vector
-		_linePositions.push_back(0);
-	}
-	
-	// Loop through string until the end
-	StringIterator* iterator = _text.newStringIterator();
-	
-	while (!endReached) {
-		breakIndex = 0;
-		lineWidth = 0;
+		// Trim blank space from the start of the next line
+		StringIterator breakIterator(&_text);
 		
-		if (iterator->moveTo(pos)) {
-			
-			// Search for line breaks and valid breakpoints until we exceed the
-			// width of the text field or we run out of string to process
-			while (lineWidth + _font->getCharWidth(iterator->getCodePoint()) <= _width) {
-				lineWidth += _font->getCharWidth(iterator->getCodePoint());
-				
-				// Check for line return
-				if (iterator->getCodePoint() == '\n') {
-					
-					// Remember this breakpoint
-					breakIndex = iterator->getIndex();
-					break;
-				} else if ((iterator->getCodePoint() == ' ') ||
-						   (iterator->getCodePoint() == ',') ||
-						   (iterator->getCodePoint() == '.') ||
-						   (iterator->getCodePoint() == '-') ||
-						   (iterator->getCodePoint() == ':') ||
-						   (iterator->getCodePoint() == ';') ||
-						   (iterator->getCodePoint() == '?') ||
-						   (iterator->getCodePoint() == '!') ||
-						   (iterator->getCodePoint() == '+') ||
-						   (iterator->getCodePoint() == '=') ||
-						   (iterator->getCodePoint() == '/') ||
-						   (iterator->getCodePoint() == '\0')) {
-					
-					// Remember the most recent breakpoint
-					breakIndex = iterator->getIndex();
-				}
-				
-				// Move to the next character
-				if (!iterator->moveToNext()) {
-					
-					// No more text; abort loop
-					endReached = true;
+		if (breakIterator.moveTo(breakIndex + 1)) {
+			while (breakIterator.getCodePoint() == ' ') {
+				if (breakIterator.moveToNext()) {
+					breakIndex++;
+				} else {
 					break;
 				}
 			}
-		} else {
-			endReached = true;
 		}
 		
-		if ((!endReached) && (iterator->getIndex() > pos)) {
-			
-			// Process any found data
-			
-			// If we didn't find a breakpoint split at the current position
-			if (breakIndex == 0) breakIndex = iterator->getIndex() - 1;
-			
-			// Trim blank space from the start of the next line
-			StringIterator* breakIterator = _text.newStringIterator();
-			
-			if (breakIterator->moveTo(breakIndex + 1)) {
-				while (breakIterator->getCodePoint() == ' ') {
-					if (breakIterator->moveToNext()) {
-						breakIndex++;
-					} else {
-						break;
-					}
-				}
-			}
-			
-			delete breakIterator;
-			
-			// Add the start of the next line to the vector
-			pos = breakIndex + 1;
-			_linePositions.push_back(pos);
-			
-			// Is this the longest line observed so far?
-			if (lineWidth > _textPixelWidth) {
-				_textPixelWidth = lineWidth;
-				
-				// Push the description of the line into the longest lines
-				// vector (note that we store the index in _linePositions that
-				// refers to the start of the line, *not* the position of the
-				// line in the char array)
-				LongestLine line;
-				line.index = _linePositions.size() - 2;
-				line.width = lineWidth;
-				_longestLines.push_back(line);
-			}
-		} else if (!endReached) {
-			
-			// Add a blank row if we're not at the end of the string
-			pos++;
-			_linePositions.push_back(pos);
-		}
+		return breakIndex + 1;
 	}
-	
-	// Add marker indicating end of text
-	// If we reached the end of the text, append the stopping point
-	if (_linePositions[_linePositions.size() - 1] != _text.getLength() + 1) {
-		_linePositions.push_back(_text.getLength());
+
+	// Add a blank row if we're not at the end of the string
+	lineWidth = 0;
+
+	return pos + 1;
+}
+
+const s32 Document::getEditLine(const s32 index) const {
+
+	if ((index <= 0) || (_linePositions.size() == 0)) return 0;
+
+	s32 line = getLineContainingCharIndex(index);
+
+	// If the line was split part-way through a word, the whole word could
+	// move back onto an earlier line, so go back to the line on which the
+	// word starts
+	while ((line > 0) && (!FontBase::isBreakpoint(_text.getCharAt(_linePositions[line] - 1)))) {
+		line--;
 	}
-	
-	delete iterator;
-	
-	// Calculate the total height of the text
-	_textPixelHeight = getLineCount() * (_font->getHeight() + _lineSpacing);
-	
-	// Ensure height is always at least one row
-	if (_textPixelHeight == 0) _textPixelHeight = _font->getHeight() + _lineSpacing;
+
+	return line > 0 ? line - 1 : 0;
 }
 
 void Document::setFont(FontBase* font) {
 	_font = font;
-	wrap();
+	rewrap();
 }
 
 void Document::stripTopLines(const s32 lines) {
@@ -293,7 +430,7 @@ void Document::stripTopLines(const s32 lines) {
 const s32 Document::getLineContainingCharIndex(const s32 index) const {
 	
 	// Early exit if there is no existing line data
-	if (_linePositions.size() == 0) return 0;
+	if (_linePositions.size() < 2) return 0;
 	
 	// Early exit if the character is in the last row
 	if (index >= _linePositions[_linePositions.size() - 2]) return _linePositions.size() - 2;
@@ -0,0 +1,72 @@
+#include "fontbase.h"
+#include "woopsistring.h"
+#include "stringiterator.h"
+
+using namespace WoopsiUI;
+
+void FontBase::measureRun(const WoopsiString& text, s32 startIndex, s32 length, s32 maxWidth, TextRun& run) const {
+
+	run.length = 0;
+	run.width = 0;
+	run.breakIndex = -1;
+	run.isNewline = false;
+
+	if (length < 1) return;
+
+	StringIterator iterator(&text);
+
+	if (!iterator.moveTo(startIndex)) return;
+
+	u32 first = 0;
+	u32 count = 0;
+	u8 defaultWidth = 0;
+	const u8* advances = getAdvanceTable(first, count, defaultWidth);
+
+	do {
+		u32 codePoint = iterator.getCodePoint();
+		u8 width;
+
+		// Characters below the start of the table wrap around to large
+		// values, so a single comparison checks both ends of the table
+		if (advances != NULL) {
+			width = codePoint - first < count ? advances[codePoint - first] : defaultWidth;
+		} else {
+			width = getCharWidth(codePoint);
+		}
+
+		if (run.width + width > maxWidth) return;
+
+		run.width += width;
+		run.length++;
+
+		if (codePoint == '\n') {
+			run.breakIndex = iterator.getIndex();
+			run.isNewline = true;
+			return;
+		}
+
+		if (isBreakpoint(codePoint)) run.breakIndex = iterator.getIndex();
+
+	} while ((run.length < length) && (iterator.moveToNext()));
+}
+
+bool FontBase::isBreakpoint(const u32 letter) {
+	switch (letter) {
+		case ' ':
+		case ',':
+		case '.':
+		case '-':
+		case ':':
+		case ';':
+		case '?':
+		case '!':
+		case '+':
+		case '=':
+		case '/':
+		case '\n':
+		case '\0':
+			return true;
+	}
+
+	return false;
+}
@@ -8,6 +8,13 @@ FrameBuffer::FrameBuffer(u16* data, u16 width, u16 height) {
 	_width = width;
 	_height = height;
 	_bitmap = data;
+
+#ifdef USING_SDL
+	clearDirtyRect();
+
+	// Nothing has been copied to the display yet, so all of it is dirty
+	markDirty(0, 0, width, height);
+#endif
 }
 
 // Get a single pixel from the bitmap
@@ -32,6 +39,8 @@ void FrameBuffer::setPixel(s16 x, s16 y, u16 colour) {
 	// Plot the pixel
 	u32 pos = (y * _width) + x;
 	_bitmap[pos] = colour;
+
+	markDirty(x, y, x + 1, y + 1);
 }
 
 const u16* FrameBuffer::getData(s16 x, s16 y) const {
@@ -47,12 +56,32 @@ const u16* FrameBuffer::getData(s16 x, s16 y) const {
 
 void FrameBuffer::blit(const s16 x, const s16 y, const u16* data, const u32 size) {
 	u16* pos = _bitmap + (y * _width) + x;
-	woopsiDmaCopy(data, pos, size);
+	woopsiDmaMove(data, pos, size);
+
+	markDirtyRun(x, y, size);
 }
 
 void FrameBuffer::blitFill(const s16 x, const s16 y, const u16 colour, const u32 size) {
 	u16* pos = _bitmap + (y * _width) + x;
 	woopsiDmaFill(colour, pos, size);
+
+	markDirtyRun(x, y, size);
+}
+
+void FrameBuffer::fillRect(s16 x, s16 y, u16 width, u16 height, const u16 colour) {
+	Rect rect;
+	if (!clipToBitmap(_width, _height, x, y, width, height, rect)) return;
+
+	markDirty(rect.x, rect.y, rect.x + rect.width, rect.y + rect.height);
+	fillData(_bitmap, _width, rect, colour);
+}
+
+void FrameBuffer::xorRect(s16 x, s16 y, u16 width, u16 height, const u16 colour) {
+	Rect rect;
+	if (!clipToBitmap(_width, _height, x, y, width, height, rect)) return;
+
+	markDirty(rect.x, rect.y, rect.x + rect.width, rect.y + rect.height);
+	xorData(_bitmap, _width, rect, colour);
 }
 
 void FrameBuffer::copy(s16 x, s16 y, u32 size, u16* dest) const {
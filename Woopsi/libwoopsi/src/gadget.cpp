@@ -1,7 +1,9 @@
 #include "contextmenu.h"
+#include "damagedrectmanager.h"
 #include "gadgetstyle.h"
 #include "gadget.h"
 #include "gadgeteventhandler.h"
+#include "graphics.h"
 #include "graphicsport.h"
 #include "fontbase.h"
 #include "framebuffer.h"
@@ -73,6 +75,7 @@ Gadget::Gadget(s16 x, s16 y, u16 width, u16 height, GadgetStyle* style) {
 	_flags.permeable = false;
 	_flags.shelved = false;
 	_flags.raisesEvents = true;
+	_flags.receivesDragPath = false;
 
 	// Set hierarchy pointers
 	_parent = NULL;
@@ -96,6 +99,10 @@ Gadget::Gadget(s16 x, s16 y, u16 width, u16 height, GadgetStyle* style) {
 
 	_rectCache = new RectCache(this);
 
+	_screenX = x;
+	_screenY = y;
+	_isScreenRectCacheValid = false;
+
 	_gadgetEventHandler = NULL;
 }
 
@@ -139,19 +146,49 @@ Gadget::~Gadget() {
 }
 
 const s16 Gadget::getX() const {
-	if (_parent != NULL) {
-		return _parent->getX() + _rect.getX();
-	}
-
-	return _rect.getX();
+	cacheScreenRect();
+	return _screenX;
 }
 
 const s16 Gadget::getY() const {
-	if (_parent != NULL) {
-		return _parent->getY() + _rect.getY();
+	cacheScreenRect();
+	return _screenY;
+}
+
+void Gadget::convertWoopsiSpaceToParentSpace(s16* x, s16* y) const {
+	if (_parent == NULL) return;
+
+	*x -= _parent->getX();
+	*y -= _parent->getY();
+
+	// Non-decoration children are positioned relative to the parent's
+	// child offset
+	if (!isDecoration()) {
+		s16 offsetX;
+		s16 offsetY;
+
+		_parent->getChildOffset(offsetX, offsetY);
+
+		*x -= offsetX;
+		*y -= offsetY;
 	}
+}
 
-	return _rect.getY();
+void Gadget::convertParentSpaceToWoopsiSpace(s16* x, s16* y) const {
+	if (_parent == NULL) return;
+
+	*x += _parent->getX();
+	*y += _parent->getY();
+
+	if (!isDecoration()) {
+		s16 offsetX;
+		s16 offsetY;
+
+		_parent->getChildOffset(offsetX, offsetY);
+
+		*x += offsetX;
+		*y += offsetY;
+	}
 }
 
 const s16 Gadget::getRelativeX() const {
@@ -240,6 +277,7 @@ void Gadget::setBorderless(bool isBorderless) {
 
 	_flags.borderless = isBorderless;
 
+	invalidateScreenRectCache();
 	invalidateVisibleRectCache();
 }
 
@@ -250,6 +288,7 @@ void Gadget::setDecoration(bool isDecoration) {
 	// the flag without breaking anything
 	if ((_parent == NULL) || _flags.shelved) {
 		_flags.decoration = isDecoration;
+		invalidateScreenRectCache();
 		return;
 	}
 
@@ -329,15 +368,7 @@ bool Gadget::checkCollisionWithForegroundRects(s16 x, s16 y) const {
 
 	cacheVisibleRects();
 
-	Rect* rect;
-
-	for (s32 i = 0; i < _rectCache->getForegroundRegions()->size(); ++i) {
-		rect = &(_rectCache->getForegroundRegions()->at(i));
-
-		if (rect->contains(x, y)) return true;
-	}
-
-	return false;
+	return _rectCache->getForegroundRegions()->contains(x, y);
 }
 
 // Check for collisions with another rectangle
@@ -368,17 +399,52 @@ bool Gadget::checkCollision(const Gadget* gadget) const {
 	return rect.intersects(gadgetRect);
 }
 
-void Gadget::redraw(const Rect& rect) {
+void Gadget::redraw(const Region& region) {
+
+	Rect rect;
+	getClientRect(rect);
+
+	FrameBuffer* bitmap = getFrameBufferForScreenNumber(getPhysicalScreenNumber());
+
+	// Ensure visible region cache is up to date
+	cacheVisibleRects();
+
+	// Create internal and standard graphics ports.  These are created on
+	// the stack as redraw() is called for every damaged gadget in every
+	// frame
+	GraphicsPort internalPort(getX(), getY(), getWidth(), getHeight(), isDrawingEnabled(), bitmap, &region, NULL);
+	GraphicsPort port(rect.x + getX(), rect.y + getY(), rect.width, rect.height, isDrawingEnabled(), bitmap, &region, NULL);
+
+	drawBorder(&internalPort);
+
+	// Skip the contents entirely if only the border was damaged
+	Rect bounds;
+	port.getClipBounds(bounds);
+
+	if (bounds.hasDimensions()) drawContents(&port, region);
+}
+
+void Gadget::drawContents(GraphicsPort* port, const Region& region) {
+
+	// The port is already clipped to a single rect
+	if (region.size() == 1) {
+		drawContents(port);
+		return;
+	}
 
-	// Create internal and standard graphics ports
-	GraphicsPort* internalPort = newInternalGraphicsPort(rect);
-	GraphicsPort* port = newGraphicsPort(rect);
+	Rect portRect(port->getX(), port->getY(), port->getWidth(), port->getHeight());
 
-	drawBorder(internalPort);
-	drawContents(port);
+	for (s32 i = 0; i < region.size(); ++i) {
+		const Rect& rect = region.at(i);
 
-	delete internalPort;
-	delete port;
+		// The region is banded, so no later rects can overlap the port
+		if (rect.y >= portRect.y + portRect.height) break;
+
+		if (!rect.intersects(portRect)) continue;
+
+		port->setClipRect(rect);
+		drawContents(port);
+	}
 }
 
 void Gadget::markRectsDamaged() {
@@ -433,6 +499,8 @@ void Gadget::close() {
 
 	// Ensure that this gadget can no longer affect the decoration count
 	_flags.decoration = false;
+
+	invalidateScreenRectCache();
 }
 
 // Erases the gadget from the display and prevents it from being redrawn
@@ -820,8 +888,11 @@ bool Gadget::moveTo(s16 x, s16 y) {
 			
 	// Perform move if necessary
 	if ((_rect.getX() != x) || (_rect.getY() != y)) {
-		
-		markRectsDamaged();
+
+		// Remember the visible region so that it can be copied rather than
+		// redrawn once the gadget has moved
+		cacheVisibleRects();
+		Region oldRegion(*_rectCache->getForegroundRegions());
 
 		s16 oldX = _rect.getX();
 		s16 oldY = _rect.getY();
@@ -829,11 +900,13 @@ bool Gadget::moveTo(s16 x, s16 y) {
 		_rect.setX(x);
 		_rect.setY(y);
 
+		invalidateScreenRectCache();
+
 		if (_parent != NULL) {
 			_parent->invalidateVisibleRectCache();
 		}
 
-		markRectsDamaged();
+		moveVisibleRegion(oldRegion, x - oldX, y - oldY);
 
 		if (raisesEvents()) {
 			_gadgetEventHandler->handleMoveEvent(*this, WoopsiPoint(x, y), WoopsiPoint(x - oldX, y - oldY));
@@ -845,6 +918,77 @@ bool Gadget::moveTo(s16 x, s16 y) {
 	return false;
 }
 
+void Gadget::moveVisibleRegion(const Region& oldRegion, s16 dx, s16 dy) {
+
+	// Abort if Woopsi does not exist.  This can occur if Woopsi is shutting
+	// down
+	if (woopsiApplication == NULL) return;
+
+	DamagedRectManager* damagedRectManager = woopsiApplication->getDamagedRectManager();
+
+	cacheVisibleRects();
+	const Region* newRegion = _rectCache->getForegroundRegions();
+
+	// Everything covered by the gadget before or after the move must be
+	// redrawn except for the areas that we can copy
+	Region damagedRegion(oldRegion);
+	damagedRegion.addRegion(*newRegion);
+
+	if (isDrawingEnabled()) {
+
+		// We can only copy pixels that are on the display and visible at
+		// both positions.  Pixels that are waiting to be redrawn are out of
+		// date, so they cannot be copied either
+		Rect display(0, getPhysicalScreenNumber() == 1 ? TOP_SCREEN_Y_OFFSET : 0, SCREEN_WIDTH, SCREEN_HEIGHT);
+
+		Region source(*newRegion);
+		source.intersectRect(display);
+		source.translate(-dx, -dy);
+		source.intersectRegion(oldRegion);
+		source.intersectRect(display);
+		source.subtractRegion(damagedRectManager->getDamagedRegion());
+
+		if (!source.isEmpty()) {
+			Graphics graphics(getFrameBufferForScreenNumber(getPhysicalScreenNumber()), Rect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT));
+
+			// Copy the bands in the direction of the move, and the rects
+			// within each band likewise, so that no rect is overwritten
+			// before it has been copied
+			s32 count = source.size();
+			s32 bandStart = dy > 0 ? count : 0;
+
+			while (dy > 0 ? bandStart > 0 : bandStart < count) {
+
+				// Find the extent of the band
+				s32 first = bandStart;
+				s32 last = bandStart;
+
+				if (dy > 0) {
+					last = bandStart - 1;
+					first = last;
+					while ((first > 0) && (source.at(first - 1).y == source.at(last).y)) --first;
+					bandStart = first;
+				} else {
+					while ((last + 1 < count) && (source.at(last + 1).y == source.at(first).y)) ++last;
+					bandStart = last + 1;
+				}
+
+				for (s32 i = first; i <= last; ++i) {
+					const Rect& rect = source.at(dx > 0 ? first + last - i : i);
+					s16 y = rect.y - display.y;
+
+					graphics.copy(rect.x, y, rect.x + dx, y + dy, rect.width, rect.height);
+				}
+			}
+
+			source.translate(dx, dy);
+			damagedRegion.subtractRegion(source);
+		}
+	}
+
+	damagedRectManager->addDamagedRegion(damagedRegion);
+}
+
 bool Gadget::resize(u16 width, u16 height) {
 
 	// Enforce gadget to stay within parent confines if necessary
@@ -878,6 +1022,8 @@ bool Gadget::resize(u16 width, u16 height) {
 		_rect.setWidth(width);
 		_rect.setHeight(height);
 
+		invalidateScreenRectCache();
+
 		// Handle visible region caching
 		if (_parent != NULL) {
 			_parent->invalidateVisibleRectCache();
@@ -1480,7 +1626,7 @@ GraphicsPort* Gadget::newGraphicsPort(bool isForeground) {
 	cacheVisibleRects();
 
 	// Choose the rect cache to use as the clipping rect list
-	WoopsiArray<Rect>* clipList = isForeground ? _rectCache->getForegroundRegions() : _rectCache->getBackgroundRegions();
+	Region* clipList = isForeground ? _rectCache->getForegroundRegions() : _rectCache->getBackgroundRegions();
 
 	return new GraphicsPort(rect.x + getX(), rect.y + getY(), rect.width, rect.height, isDrawingEnabled(), bitmap, clipList, NULL);
 }
@@ -1524,43 +1670,18 @@ GraphicsPort* Gadget::newInternalGraphicsPort(Rect clipRect) {
 }
 
 // Return vector of visible rects, including any covered by children
-WoopsiArray<Rect>* Gadget::getForegroundRegions() {
+Region* Gadget::getForegroundRegions() {
 	return _rectCache->getForegroundRegions();
 }
 
-// Move up hierarchy, clipping rect to each ancestor
+// Clip rect to the area of the ancestors that the gadget can draw within
 void Gadget::clipRectToHierarchy(Rect& rect) const {
 
-	const Gadget* parent = _parent;
-	const Gadget* gadget = this;
-	Rect thisRect;
-
-	while (parent != NULL) {
+	if (_parent == NULL) return;
 
-		// Copy parent's properties into the rect
-		if (gadget->isDecoration()) {
+	cacheScreenRect();
 
-			// Decorations can draw over entire gadget
-			thisRect.x = parent->getX();
-			thisRect.y = parent->getY();
-			thisRect.width = parent->getWidth();
-			thisRect.height = parent->getHeight();
-		} else {
-
-			// Standard gadgets can draw into client space
-			parent->getClientRect(thisRect);
-
-			// Adjust rect to screen space
-			thisRect.x += parent->getX();
-			thisRect.y += parent->getY();
-		}
-
-		rect.clipToIntersect(thisRect);
-
-		// Send up to parent
-		gadget = parent;
-		parent = parent->getParent();
-	}
+	rect.clipToIntersect(_hierarchyClipRect);
 }
 
 // Get the gadget's rect clipped to the dimensions of the parent
@@ -1575,6 +1696,69 @@ void Gadget::getRectClippedToHierarchy(Rect& rect) const {
 	clipRectToHierarchy(rect);
 }
 
+void Gadget::invalidateScreenRectCache() {
+
+	// Descendants can only have valid caches if this gadget's cache is valid,
+	// so there is nothing more to do if it is already invalid
+	if (!_isScreenRectCacheValid) return;
+
+	_isScreenRectCacheValid = false;
+
+	for (s32 i = 0; i < _gadgets.size(); ++i) {
+		_gadgets[i]->invalidateScreenRectCache();
+	}
+
+	for (s32 i = 0; i < _shelvedGadgets.size(); ++i) {
+		_shelvedGadgets[i]->invalidateScreenRectCache();
+	}
+}
+
+void Gadget::cacheScreenRect() const {
+
+	if (_isScreenRectCacheValid) return;
+
+	if (_parent == NULL) {
+		_screenX = _rect.getX();
+		_screenY = _rect.getY();
+	} else {
+		_screenX = _parent->getX() + _rect.getX();
+		_screenY = _parent->getY() + _rect.getY();
+
+		// Decorations are fixed to the parent; everything else moves with
+		// the parent's child offset
+		if (!isDecoration()) {
+			s16 offsetX;
+			s16 offsetY;
+
+			_parent->getChildOffset(offsetX, offsetY);
+
+			_screenX += offsetX;
+			_screenY += offsetY;
+		}
+
+		// Work out the area of the parent that we can draw into, clipped to
+		// the parent's own ancestors.  This is the rect that ancestors clip
+		// to when walking up the hierarchy one gadget at a time.
+		if (isDecoration()) {
+
+			// Decorations can draw over entire gadget
+			_parent->getRectClippedToHierarchy(_hierarchyClipRect);
+		} else {
+
+			// Standard gadgets can draw into client space
+			_parent->getClientRect(_hierarchyClipRect);
+
+			// Adjust rect to screen space
+			_hierarchyClipRect.x += _parent->getX();
+			_hierarchyClipRect.y += _parent->getY();
+
+			_parent->clipRectToHierarchy(_hierarchyClipRect);
+		}
+	}
+
+	_isScreenRectCacheValid = true;
+}
+
 FontBase* Gadget::getFont() const {
 	return _style.font;
 }
@@ -1784,6 +1968,8 @@ void Gadget::setBorderSize(const GadgetBorderSize& borderSize) {
 	_borderSize.right = borderSize.right;
 	_borderSize.bottom = borderSize.bottom;
 	_borderSize.left = borderSize.left;
+
+	invalidateScreenRectCache();
 }
 
 const u8 Gadget::getPhysicalScreenNumber() const {
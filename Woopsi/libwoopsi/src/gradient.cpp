@@ -54,7 +54,7 @@ void Gradient::cacheRowColours() {
 	if (_rowColour != NULL) { delete [] _rowColour; }
 	
 	// Allocate new cache
-	_rowColour = new s16[getHeight()];
+	_rowColour = new u16[getHeight()];
 	
 	// Calculate the colours for each row
 	s16 colourR, colourG, colourB;
@@ -80,23 +80,9 @@ void Gradient::cacheRowColours() {
 
 void Gradient::drawContents(GraphicsPort* port) {
 
-	port->drawFilledRect(0, 0, getWidth(), getHeight(), getBackColour());
-
-	Rect rect;
-	port->getClipRect(rect);
-		
-	u16 row = rect.y;
-
-	// Loop through all lines within this clipping region
-	u16 y = 0;		
-	while (y < rect.height) {
-	
-		// Draw line (y value adjusted back to gadget space from screen space)
-		port->drawLine(0, row, getWidth() - 1, row, _rowColour[row]);
-
-		row++;
-		y++;
-	}
+	// Each row is a single colour, so the gradient can be drawn in one pass
+	// over the clipping region without filling the background first
+	port->drawFilledRows(0, 0, getWidth(), getHeight(), _rowColour);
 }
 
 void Gradient::onResize(u16 width, u16 height) {
@@ -32,7 +32,7 @@ void Graphics::setClipRect(const Rect& clipRect) {
 	}
 
 	if (_clipRect.width + _clipRect.x > _width) _clipRect.width = _width - _clipRect.x;
-	if (_clipRect.height + _clipRect.y > _height) _clipRect.height = _height - clipRect.y;
+	if (_clipRect.height + _clipRect.y > _height) _clipRect.height = _height - _clipRect.y;
 }
 
 void Graphics::getClipRect(Rect& rect) const {
@@ -106,13 +106,24 @@ void Graphics::drawFilledRect(s16 x, s16 y, u16 width, u16 height, u16 colour) {
 	// Attempt to clip
 	if (!clipCoordinates(&x, &y, &x2, &y2, _clipRect)) return;
 		
-	// Calculate new width/height
-	width = x2 - x + 1;
-	height = y2 - y + 1;
-		
 	// Draw the rectangle
-	for (u16 i = 0; i < height; i++) {
-		drawHorizLine(x, y + i, width, colour);
+	_bitmap->fillRect(x, y, x2 - x + 1, y2 - y + 1, colour);
+}
+
+void Graphics::drawFilledRows(s16 x, s16 y, u16 width, u16 height, const u16* rowColours) {
+
+	s16 top = y;
+
+	// Get end point of rect to draw
+	s16 x2 = x + width - 1;
+	s16 y2 = y + height - 1;
+	
+	// Attempt to clip
+	if (!clipCoordinates(&x, &y, &x2, &y2, _clipRect)) return;
+
+	// Fill each visible row with its colour
+	for (s16 row = y; row <= y2; ++row) {
+		_bitmap->fillRect(x, row, x2 - x + 1, 1, rowColours[row - top]);
 	}
 }
 
@@ -125,11 +136,8 @@ void Graphics::drawHorizLine(s16 x, s16 y, u16 width, u16 colour) {
 	// Attempt to clip
 	if (!clipCoordinates(&x, &y, &x2, &y2, _clipRect)) return;
 		
-	// Calculate new width
-	width = x2 - x + 1;
-	
 	// Draw the line
-	_bitmap->blitFill(x, y, colour, width);
+	_bitmap->fillRect(x, y, x2 - x + 1, 1, colour);
 }
 
 void Graphics::drawVertLine(s16 x, s16 y, u16 height, u16 colour) {
@@ -141,13 +149,8 @@ void Graphics::drawVertLine(s16 x, s16 y, u16 height, u16 colour) {
 	// Attempt to clip
 	if (!clipCoordinates(&x, &y, &x2, &y2, _clipRect)) return;
 		
-	// Calculate new height
-	height = y2 - y + 1;
-		
 	// Draw the line
-	for (u16 i = 0; i < height; i++) {
-		_bitmap->setPixel(x, y + i, colour);
-	}
+	_bitmap->fillRect(x, y, 1, y2 - y + 1, colour);
 }
 
 void Graphics::drawRect(s16 x, s16 y, u16 width, u16 height, u16 colour) {
@@ -244,18 +247,16 @@ void Graphics::drawText(s16 x, s16 y, FontBase* font, const WoopsiString& string
 	if (!clipCoordinates(&textX1, &textY1, &textX2, &textY2, _clipRect)) return;
 		
 	// Draw the string char by char
-	StringIterator* iterator = string.newStringIterator();
+	StringIterator iterator(&string);
 		
-	if (iterator->moveTo(startIndex)) {
+	if (iterator.moveTo(startIndex)) {
 		do {
-			x = font->drawChar(_bitmap, iterator->getCodePoint(), colour, x, y, clipX1, clipY1, clipX2, clipY2);
+			x = font->drawChar(_bitmap, iterator.getCodePoint(), colour, x, y, clipX1, clipY1, clipX2, clipY2);
 
 			// Abort if x pos outside clipping region
 			if (x > clipX2) break;
-		} while (iterator->moveToNext() && (iterator->getIndex() < startIndex + length));
+		} while (iterator.moveToNext() && (iterator.getIndex() < startIndex + length));
 	}
-
-	delete iterator;
 }
 
 void Graphics::drawBaselineText(s16 x, s16 y, FontBase* font, const WoopsiString& string, s32 startIndex, s32 length, u16 colour) {
@@ -266,17 +267,16 @@ void Graphics::drawBaselineText(s16 x, s16 y, FontBase* font, const WoopsiString
 	s16 clipY2 = _clipRect.y + _clipRect.height - 1;
 		
 	// Draw the string char by char
-	StringIterator* iterator = string.newStringIterator();
+	StringIterator iterator(&string);
 		
 	// We can't do the same exit checks as we have no idea of the height, width, top of the string
 	// We would need lineHeight, lineTop, lineWidth and that wouldn't tell us 
 	// where to stop rendering anyway clipping will be done in the font, on a char basis 
-	if (iterator->moveTo(startIndex)) {
+	if (iterator.moveTo(startIndex)) {
 		do {
-		        x = font->drawBaselineChar(_bitmap, iterator->getCodePoint(), colour, x, y, clipX1, clipY1, clipX2, clipY2);
-		} while (iterator->moveToNext() && (iterator->getIndex() < startIndex + length));
+		        x = font->drawBaselineChar(_bitmap, iterator.getCodePoint(), colour, x, y, clipX1, clipY1, clipX2, clipY2);
+		} while (iterator.moveToNext() && (iterator.getIndex() < startIndex + length));
 	}
-	delete iterator;
 }
 
 void Graphics::drawXORPixel(s16 x, s16 y) {
@@ -293,11 +293,8 @@ void Graphics::drawXORPixel(s16 x, s16 y, u16 colour) {
 	// Attempt to clip
 	if (!clipCoordinates(&clipX1, &clipY1, &clipX2, &clipY2, _clipRect)) return;
 
-	// Get the pixel at the specified co-ords and XOR against supplied colour
-	u16 newColour = (_bitmap->getPixel(x, y) ^ colour) | (1 << 15);
-
-	// Draw the XORed pixel colour to the bitmap
-	_bitmap->setPixel(x, y, newColour);
+	// XOR the pixel at the specified co-ords against supplied colour
+	_bitmap->xorRect(x, y, 1, 1, colour);
 }
 
 void Graphics::drawXORHorizLine(s16 x, s16 y, u16 width, u16 colour) {
@@ -309,13 +306,8 @@ void Graphics::drawXORHorizLine(s16 x, s16 y, u16 width, u16 colour) {
 	// Attempt to clip
 	if (!clipCoordinates(&x, &y, &x2, &y2, _clipRect)) return;
 		
-	// Calculate new width
-	width = x2 - x + 1;
-	
 	// Draw the line
-	for (u16 i = 0; i < width; i++) {
-		drawXORPixel(x + i, y, colour);
-	}
+	_bitmap->xorRect(x, y, x2 - x + 1, 1, colour);
 }
 
 void Graphics::drawXORVertLine(s16 x, s16 y, u16 height, u16 colour) {
@@ -327,13 +319,8 @@ void Graphics::drawXORVertLine(s16 x, s16 y, u16 height, u16 colour) {
 	// Attempt to clip
 	if (!clipCoordinates(&x, &y, &x2, &y2, _clipRect)) return;
 		
-	// Calculate new height
-	height = y2 - y + 1;
-	
 	// Draw the line
-	for (u16 i = 0; i < height; i++) {
-		drawXORPixel(x, y + i, colour);
-	}
+	_bitmap->xorRect(x, y, 1, y2 - y + 1, colour);
 }
 
 void Graphics::drawXORHorizLine(s16 x, s16 y, u16 width) {
@@ -352,9 +339,16 @@ void Graphics::drawXORRect(s16 x, s16 y, u16 width, u16 height, u16 colour) {
 }
 
 void Graphics::drawFilledXORRect(s16 x, s16 y, u16 width, u16 height, u16 colour) {
-	for (s32 j = 0; j < height; j++) {
-		drawXORHorizLine(x, y + j, width, colour);
-	}
+
+	// Get end point of rect to draw
+	s16 x2 = x + width - 1;
+	s16 y2 = y + height - 1;
+	
+	// Attempt to clip
+	if (!clipCoordinates(&x, &y, &x2, &y2, _clipRect)) return;
+
+	// Draw the rectangle
+	_bitmap->xorRect(x, y, x2 - x + 1, y2 - y + 1, colour);
 }
 
 void Graphics::drawXORRect(s16 x, s16 y, u16 width, u16 height) {
@@ -930,30 +924,9 @@ void Graphics::copy(s16 sourceX, s16 sourceY, s16 destX, s16 destY, u16 width, u
 	width = x2 + 1 - destX;
 	height = y2 + 1 - destY;
 	
-	// If there is no vertical movement and the source and destination overlap,
-	// we need to use an offscreen buffer to copy
-	if (sourceY == destY) {
-		if ((destX >= sourceX) && (destX <= sourceX + width)) {
-			u16* buffer = new u16[width];
-			
-			for (u16 y = 0; y < height; y++) {
-				
-				// Copy row to buffer
-				_bitmap->copy(sourceX, sourceY + y, width, buffer);
-				
-				// Copy row back to screen
-				_bitmap->blit(destX, destY + y, buffer, width);
-			}
-			
-			delete[] buffer;
-			
-			return;
-		}
-	}
-	
-	// Vertical movement or non overlap means we do not need to use an intermediate buffer
 	// Copy from top to bottom if moving up; from bottom to top if moving down.
-	// Ensures that rows to be copied are not overwritten
+	// Ensures that rows to be copied are not overwritten.  Horizontal overlap
+	// within a row is handled by blit(), which copies overlapping data safely
 	if (sourceY > destY) {
 		
 		// Copy up
@@ -1,608 +1,651 @@
-#include "graphicsport.h"
-#include "defines.h"
-#include "fontbase.h"
-#include "woopsifuncs.h"
-#include "framebuffer.h"
-#include "bitmapbase.h"
-#include "stringiterator.h"
-
-using namespace WoopsiUI;
-
-GraphicsPort::GraphicsPort(const s16 x, const s16 y, const u16 width, const u16 height, const bool isEnabled, FrameBuffer* bitmap, const WoopsiArray<Rect>* clipRectList, const Rect* clipRect) {
-	_rect.x = x;
-	_rect.y = y;
-	_rect.width = width;
-	_rect.height = height;
-	_isEnabled = isEnabled;
-	
-	_isTopScreen = (y >= TOP_SCREEN_Y_OFFSET) && (SCREEN_COUNT > 1);
-	
-	if (_isTopScreen) {
-		int j = 0;
-		j++;
-	}
-
-	_graphics = bitmap->newGraphics();
-	
-	// Set up clip rect
-	if (clipRect != NULL) {
-		setClipRect(*clipRect);
-	} else {
-
-		// Set up clip rect list
-		if (clipRectList != NULL) {
-			for (s32 i = 0; i < clipRectList->size(); ++i) {
-				addClipRect(clipRectList->at(i));
-			}
-		}
-	}
-}
-
-void GraphicsPort::addClipRect(const Rect& clipRect) {
-
-	// Clip rect is clipped to the dimensions of the
-	// GraphicsPort before it is stored.  This means
-	// we eliminate a lot of complexity when drawing - 
-	// we clip to rects, which are guaranteed to be
-	// accurate - rather than trying to clip to both
-	// the rects and the dimensions of the port.  It
-	// also means we can ignore any cliprects that get
-	// totally clipped out before they even get into
-	// the port.
-	Rect rect(clipRect);
-	rect.clipToIntersect(_rect);
-
-	// Do not add the rect if it has no size; we don't need to try and draw
-	// empty rects
-	if (!rect.hasDimensions()) return;
-	
-	_clipRectList.push_back(rect);
-}
-
-void GraphicsPort::setClipRect(const Rect& clipRect) {
-	_clipRectList.clear();
-	addClipRect(clipRect);
-}
-
-void GraphicsPort::getClipRect(Rect& rect) const {
-
-	// The rect is adjusted such that its co-ordinates are relative to the
-	// GraphicsPort before it is returned.  This makes using the rect
-	// to optimise drawing easier.
-	rect.x = _clipRectList[0].x - getX();
-	rect.y = _clipRectList[0].y - getY();
-	rect.width = _clipRectList[0].width;
-	rect.height = _clipRectList[0].height;
-}
-
-// Print a string in a specific colour
-void GraphicsPort::drawText(s16 x, s16 y, FontBase* font, const WoopsiString& string, s32 startIndex, s32 length, u16 colour) {
-	
-	// Ignore command if drawing is disabled
-	if (!_isEnabled) return;
-
-	// Adjust from port-space to screen-space
-	convertPortToScreenSpace(&x, &y);
-	
-	Rect rect;
-	
-	// Draw all visible rects
-	for (s32 i = 0; i < _clipRectList.size(); i++) {
-		
-		// Adjust from graphicsport co-ordinates to framebuffer co-ordinates
-		_clipRectList.at(i).copyTo(rect);
-		
-		if (_isTopScreen) rect.y -= TOP_SCREEN_Y_OFFSET;
-		
-		_graphics->setClipRect(rect);
-		_graphics->drawText(x, y, font, string, startIndex, length, colour);
-	}
-}
-
-// Print a string in a specific colour on a baseline
-void GraphicsPort::drawBaselineText(s16 x, s16 y, FontBase* font, const WoopsiString& string, s32 startIndex, s32 length, u16 colour) {
-	
-	// Ignore command if drawing is disabled
-	if (!_isEnabled) return;
-
-	// Adjust from port-space to screen-space
-	convertPortToScreenSpace(&x, &y);
-	
-	Rect rect;
-	
-	// Draw all visible rects
-	for (s32 i = 0; i < _clipRectList.size(); i++) {
-		
-		// Adjust from graphicsport co-ordinates to framebuffer co-ordinates
-		_clipRectList.at(i).copyTo(rect);
-		
-		if (_isTopScreen) rect.y -= TOP_SCREEN_Y_OFFSET;
-		
-		_graphics->setClipRect(rect);
-		_graphics->drawBaselineText(x, y, font, string, startIndex, length, colour);
-	}
-}
-
-void GraphicsPort::drawText(s16 x, s16 y, FontBase* font, const WoopsiString& string) {
-	drawText(x, y, font, string, 0, string.getLength());
-}
-
-// Draw filled rectangle - external function
-void GraphicsPort::drawFilledRect(s16 x, s16 y, u16 width, u16 height, u16 colour) {
-	
-	// Ignore command if drawing is disabled
-	if (!_isEnabled) return;
-	
-	// Adjust from port-space to screen-space
-	convertPortToScreenSpace(&x, &y);
-
-	Rect rect;
-	
-	// Draw all visible rects
-	for (s32 i = 0; i < _clipRectList.size(); i++) {
-		
-		// Adjust from graphicsport co-ordinates to framebuffer co-ordinates
-		_clipRectList.at(i).copyTo(rect);
-		
-		if (_isTopScreen) rect.y -= TOP_SCREEN_Y_OFFSET;
-		
-		_graphics->setClipRect(rect);
-		_graphics->drawFilledRect(x, y, width, height, colour);
-	}
-}
-
-void GraphicsPort::drawEllipse(s16 xCentre, s16 yCentre, s16 horizRadius, s16 vertRadius, u16 colour) {
-	
-	// Ignore command if drawing is disabled
-	if (!_isEnabled) return;
-	
-	// Adjust from port-space to screen-space
-	convertPortToScreenSpace(&xCentre, &yCentre);
-	
-	Rect rect;
-	
-	// Draw all visible rects
-	for (s32 i = 0; i < _clipRectList.size(); i++) {
-		
-		// Adjust from graphicsport co-ordinates to framebuffer co-ordinates
-		_clipRectList.at(i).copyTo(rect);
-		
-		if (_isTopScreen) rect.y -= TOP_SCREEN_Y_OFFSET;
-		
-		_graphics->setClipRect(rect);
-		_graphics->drawEllipse(xCentre, yCentre, horizRadius, vertRadius, colour);
-	}
-}
-
-
-void GraphicsPort::drawFilledEllipse(s16 xCentre, s16 yCentre, s16 horizRadius, s16 vertRadius, u16 colour) {
-	
-	// Ignore command if drawing is disabled
-	if (!_isEnabled) return;
-	
-	// Adjust from port-space to screen-space
-	convertPortToScreenSpace(&xCentre, &yCentre);
-	
-	Rect rect;
-	
-	// Draw all visible rects
-	for (s32 i = 0; i < _clipRectList.size(); i++) {
-		
-		// Adjust from graphicsport co-ordinates to framebuffer co-ordinates
-		_clipRectList.at(i).copyTo(rect);
-		
-		if (_isTopScreen) rect.y -= TOP_SCREEN_Y_OFFSET;
-		
-		_graphics->setClipRect(rect);
-		_graphics->drawFilledEllipse(xCentre, yCentre, horizRadius, vertRadius, colour);
-	}
-}
-
-void GraphicsPort::drawRect(s16 x, s16 y, u16 width, u16 height, u16 colour) {
-	
-	// Ignore command if drawing is disabled
-	if (!_isEnabled) return;
-	
-	// Adjust from port-space to screen-space
-	convertPortToScreenSpace(&x, &y);
-
-	Rect rect;
-	
-	// Draw all visible rects
-	for (s32 i = 0; i < _clipRectList.size(); i++) {
-		
-		// Adjust from graphicsport co-ordinates to framebuffer co-ordinates
-		_clipRectList.at(i).copyTo(rect);
-		
-		if (_isTopScreen) rect.y -= TOP_SCREEN_Y_OFFSET;
-		
-		_graphics->setClipRect(rect);
-		_graphics->drawRect(x, y, width, height, colour);
-	}
-}
-
-void GraphicsPort::drawBevelledRect(s16 x, s16 y, u16 width, u16 height, u16 shineColour, u16 shadowColour) {
-	
-	// Ignore command if drawing is disabled
-	if (!_isEnabled) return;
-	
-	// Adjust from port-space to screen-space
-	convertPortToScreenSpace(&x, &y);
-	
-	Rect rect;
-	
-	// Draw all visible rects
-	for (s32 i = 0; i < _clipRectList.size(); i++) {
-		
-		// Adjust from graphicsport co-ordinates to framebuffer co-ordinates
-		_clipRectList.at(i).copyTo(rect);
-		
-		if (_isTopScreen) rect.y -= TOP_SCREEN_Y_OFFSET;
-		
-		_graphics->setClipRect(rect);
-		_graphics->drawBevelledRect(x, y, width, height, shineColour, shadowColour);
-	}
-}
-
-void GraphicsPort::drawFilledXORRect(s16 x, s16 y, u16 width, u16 height, u16 colour) {
-	
-	// Ignore command if drawing is disabled
-	if (!_isEnabled) return;
-	
-	// Adjust from port-space to screen-space
-	convertPortToScreenSpace(&x, &y);
-
-	Rect rect;
-	
-	// Draw all visible rects
-	for (s32 i = 0; i < _clipRectList.size(); i++) {
-		
-		// Adjust from graphicsport co-ordinates to framebuffer co-ordinates
-		_clipRectList.at(i).copyTo(rect);
-		
-		if (_isTopScreen) rect.y -= TOP_SCREEN_Y_OFFSET;
-		
-		_graphics->setClipRect(rect);
-		_graphics->drawFilledXORRect(x, y, width, height, colour);
-	}
-}
-
-void GraphicsPort::drawFilledXORRect(s16 x, s16 y, u16 width, u16 height) {
-	drawFilledXORRect(x, y, width, height, 0xffff);
-}
-
-void GraphicsPort::drawXORRect(s16 x, s16 y, u16 width, u16 height) {
-	drawXORRect(x, y, width, height, 0xffff);
-}
-
-void GraphicsPort::drawXORRect(s16 x, s16 y, u16 width, u16 height, u16 colour) {
-	
-	// Ignore command if drawing is disabled
-	if (!_isEnabled) return;
-	
-	// Adjust from port-space to screen-space
-	convertPortToScreenSpace(&x, &y);
-
-	Rect rect;
-	
-	// Draw all visible rects
-	for (s32 i = 0; i < _clipRectList.size(); i++) {
-		
-		// Adjust from graphicsport co-ordinates to framebuffer co-ordinates
-		_clipRectList.at(i).copyTo(rect);
-		
-		if (_isTopScreen) rect.y -= TOP_SCREEN_Y_OFFSET;
-		
-		_graphics->setClipRect(rect);
-		_graphics->drawXORRect(x, y, width, height, colour);
-	}
-}
-
-//Draw bitmap - external function
-void GraphicsPort::drawBitmap(s16 x, s16 y, u16 width, u16 height, const BitmapBase* bitmap, s16 bitmapX, s16 bitmapY) {
-	
-	// Ignore command if drawing is disabled
-	if (!_isEnabled) return;
-
-	// Adjust from port-space to screen-space
-	convertPortToScreenSpace(&x, &y);
-	
-	Rect rect;
-	
-	// Draw all visible rects
-	for (s32 i = 0; i < _clipRectList.size(); i++) {
-		
-		// Adjust from graphicsport co-ordinates to framebuffer co-ordinates
-		_clipRectList.at(i).copyTo(rect);
-		
-		if (_isTopScreen) rect.y -= TOP_SCREEN_Y_OFFSET;
-		
-		_graphics->setClipRect(rect);
-		_graphics->drawBitmap(x, y, width, height, bitmap, bitmapX, bitmapY);
-	}
-}
-
-//Draw bitmap with transparency - external function
-void GraphicsPort::drawBitmap(s16 x, s16 y, u16 width, u16 height, const BitmapBase* bitmap, s16 bitmapX, s16  bitmapY, u16 transparentColour) {
-	
-	// Ignore command if drawing is disabled
-	if (!_isEnabled) return;
-	
-	// Adjust from port-space to screen-space
-	convertPortToScreenSpace(&x, &y);
-	
-	Rect rect;
-	
-	// Draw all visible rects
-	for (s32 i = 0; i < _clipRectList.size(); i++) {
-		
-		// Adjust from graphicsport co-ordinates to framebuffer co-ordinates
-		_clipRectList.at(i).copyTo(rect);
-		
-		if (_isTopScreen) rect.y -= TOP_SCREEN_Y_OFFSET;
-		
-		_graphics->setClipRect(rect);
-		_graphics->drawBitmap(x, y, width, height, bitmap, bitmapX, bitmapY, transparentColour);
-	}
-}
-
-void GraphicsPort::drawBitmapGreyScale(s16 x, s16 y, u16 width, u16 height, const BitmapBase* bitmap, s16 bitmapX, s16 bitmapY) {
-	
-	// Ignore command if drawing is disabled
-	if (!_isEnabled) return;
-
-	// Adjust from port-space to screen-space
-	convertPortToScreenSpace(&x, &y);
-
-	Rect rect;
-	
-	// Draw all visible rects
-	for (s32 i = 0; i < _clipRectList.size(); i++) {
-		
-		// Adjust from graphicsport co-ordinates to framebuffer co-ordinates
-		_clipRectList.at(i).copyTo(rect);
-		
-		if (_isTopScreen) rect.y -= TOP_SCREEN_Y_OFFSET;
-		
-		_graphics->setClipRect(rect);
-		_graphics->drawBitmapGreyScale(x, y, width, height, bitmap, bitmapX, bitmapY);
-	}
-}
-
-void GraphicsPort::drawXORHorizLine(s16 x, s16 y, u16 width) {
-	drawXORHorizLine(x, y, width, 0xffff);
-}
-
-void GraphicsPort::drawXORHorizLine(s16 x, s16 y, u16 width, u16 colour) {
-	
-	// Ignore command if drawing is disabled
-	if (!_isEnabled) return;
-	
-	// Adjust from port-space to screen-space
-	convertPortToScreenSpace(&x, &y);
-
-	Rect rect;
-	
-	// Draw all visible rects
-	for (s32 i = 0; i < _clipRectList.size(); i++) {
-		
-		// Adjust from graphicsport co-ordinates to framebuffer co-ordinates
-		_clipRectList.at(i).copyTo(rect);
-		
-		if (_isTopScreen) rect.y -= TOP_SCREEN_Y_OFFSET;
-		
-		_graphics->setClipRect(rect);
-		_graphics->drawXORHorizLine(x, y, width, colour);
-	}
-}
-
-void GraphicsPort::drawXORVertLine(s16 x, s16 y, u16 height, u16 colour) {
-	
-	// Ignore command if drawing is disabled
-	if (!_isEnabled) return;
-	
-	// Adjust from port-space to screen-space
-	convertPortToScreenSpace(&x, &y);
-
-	Rect rect;
-	
-	// Draw all visible rects
-	for (s32 i = 0; i < _clipRectList.size(); i++) {
-		
-		// Adjust from graphicsport co-ordinates to framebuffer co-ordinates
-		_clipRectList.at(i).copyTo(rect);
-		
-		if (_isTopScreen) rect.y -= TOP_SCREEN_Y_OFFSET;
-		
-		_graphics->setClipRect(rect);
-		_graphics->drawXORVertLine(x, y, height, colour);
-	}
-}
-
-void GraphicsPort::drawXORVertLine(s16 x, s16 y, u16 height) {
-	drawXORVertLine(x, y, height, 0xffff);
-}
-
-// Adjust co-ords from port-space to screen-space
-void GraphicsPort::convertPortToScreenSpace(s16* x, s16* y) {
-	*x += getX();
-	*y += getY();
-
-	// Compensate for top screen offset
-	if (_isTopScreen) *y -= TOP_SCREEN_Y_OFFSET;
-}
-
-void GraphicsPort::drawPixel(s16 x, s16 y, u16 colour) {
-	
-	// Ignore command if drawing is disabled
-	if (!_isEnabled) return;
-	
-	// Adjust from port-space to screen-space
-	convertPortToScreenSpace(&x, &y);
-	
-	Rect rect;
-	
-	// Draw all visible rects
-	for (s32 i = 0; i < _clipRectList.size(); i++) {
-		
-		// Adjust from graphicsport co-ordinates to framebuffer co-ordinates
-		_clipRectList.at(i).copyTo(rect);
-
-		if (_isTopScreen) rect.y -= TOP_SCREEN_Y_OFFSET;
-		
-		_graphics->setClipRect(rect);
-		_graphics->drawPixel(x, y, colour);
-	}
-}
-
-void GraphicsPort::drawXORPixel(s16 x, s16 y) {
-	drawXORPixel(x, y, 0xffff);
-}
-
-void GraphicsPort::drawXORPixel(s16 x, s16 y, u16 colour) {
-	
-	// Ignore command if drawing is disabled
-	if (!_isEnabled) return;
-	
-	// Adjust from port-space to screen-space
-	convertPortToScreenSpace(&x, &y);
-
-	Rect rect;
-	
-	// Draw all visible rects
-	for (s32 i = 0; i < _clipRectList.size(); i++) {
-		
-		// Adjust from graphicsport co-ordinates to framebuffer co-ordinates
-		_clipRectList.at(i).copyTo(rect);
-		
-		if (_isTopScreen) rect.y -= TOP_SCREEN_Y_OFFSET;
-		
-		_graphics->setClipRect(rect);
-		_graphics->drawXORPixel(x, y, colour);
-	}
-}
-
-void GraphicsPort::drawLine(s16 x1, s16 y1, s16 x2, s16 y2, u16 colour) {
-	
-	// Ignore command if drawing is disabled
-	if (!_isEnabled) return;
-	
-	// Adjust from port-space to screen-space
-	convertPortToScreenSpace(&x1, &y1);
-	convertPortToScreenSpace(&x2, &y2);
-
-	Rect rect;
-	
-	// Draw all visible rects
-	for (s32 i = 0; i < _clipRectList.size(); i++) {
-		
-		// Adjust from graphicsport co-ordinates to framebuffer co-ordinates
-		_clipRectList.at(i).copyTo(rect);
-		
-		if (_isTopScreen) rect.y -= TOP_SCREEN_Y_OFFSET;
-		
-		_graphics->setClipRect(rect);
-		_graphics->drawLine(x1, y1, x2, y2, colour);
-	}
-}
-
-void GraphicsPort::copy(s16 sourceX, s16 sourceY, s16 destX, s16 destY, u16 width, u16 height) {
-	
-	// Ignore command if drawing is disabled
-	if (!_isEnabled) return;
-
-	// Adjust from port-space to screen-space
-	convertPortToScreenSpace(&sourceX, &sourceY);
-	convertPortToScreenSpace(&destX, &destY);
-
-	Rect rect;
-	
-	// Draw all visible rects
-	for (s32 i = 0; i < _clipRectList.size(); i++) {
-		
-		// Adjust from graphicsport co-ordinates to framebuffer co-ordinates
-		_clipRectList.at(i).copyTo(rect);
-		
-		if (_isTopScreen) rect.y -= TOP_SCREEN_Y_OFFSET;
-		
-		_graphics->setClipRect(rect);
-		_graphics->copy(sourceX, sourceY, destX, destY, width, height);
-	}
-}
-
-void GraphicsPort::scroll(s16 x, s16 y, s16 xDistance, s16 yDistance, u16 width, u16 height, WoopsiArray<Rect>* revealedRects) {
-	
-	// Ignore command if drawing is disabled
-	if (!_isEnabled) return;
-	
-	// Adjust from port-space to screen-space
-	convertPortToScreenSpace(&x, &y);
-
-	Rect rect;
-	
-	// Draw all visible rects
-	for (s32 i = 0; i < _clipRectList.size(); i++) {
-		
-		// Adjust from graphicsport co-ordinates to framebuffer co-ordinates
-		_clipRectList.at(i).copyTo(rect);
-		
-		if (_isTopScreen) rect.y -= TOP_SCREEN_Y_OFFSET;
-		
-		_graphics->setClipRect(rect);
-		_graphics->scroll(x, y, xDistance, yDistance, width, height, revealedRects);
-	}
-	
-	// Adjust revealedRects back to graphicsport space
-	for (s32 i = 0; i < revealedRects->size(); ++i) {
-		revealedRects->at(i).x -= _rect.x;
-		revealedRects->at(i).y -= _rect.y;
-		
-		if (_isTopScreen) revealedRects->at(i).y += TOP_SCREEN_Y_OFFSET;
-	}
-}
-
-void GraphicsPort::dim(s16 x, s16 y, u16 width, u16 height) {
-
-	// Ignore command if drawing is disabled
-	if (!_isEnabled) return;
-	
-	// Adjust from port-space to screen-space
-	convertPortToScreenSpace(&x, &y);
-
-	Rect rect;
-	
-	// Draw all visible rects
-	for (s32 i = 0; i < _clipRectList.size(); i++) {
-		
-		// Adjust from graphicsport co-ordinates to framebuffer co-ordinates
-		_clipRectList.at(i).copyTo(rect);
-		
-		if (_isTopScreen) rect.y -= TOP_SCREEN_Y_OFFSET;
-		
-		_graphics->setClipRect(rect);
-		_graphics->dim(x, y, width, height);
-	}
-}
-
-void GraphicsPort::greyScale(s16 x, s16 y, u16 width, u16 height) {
-
-	// Ignore command if drawing is disabled
-	if (!_isEnabled) return;
-	
-	// Adjust from port-space to screen-space
-	convertPortToScreenSpace(&x, &y);
-
-	Rect rect;
-	
-	// Draw all visible rects
-	for (s32 i = 0; i < _clipRectList.size(); i++) {
-		
-		// Adjust from graphicsport co-ordinates to framebuffer co-ordinates
-		_clipRectList.at(i).copyTo(rect);
-		
-		if (_isTopScreen) rect.y -= TOP_SCREEN_Y_OFFSET;
-		
-		_graphics->setClipRect(rect);
-		_graphics->greyScale(x, y, width, height);
-	}
-}
+#include "graphicsport.h"
+#include "defines.h"
+#include "fontbase.h"
+#include "woopsifuncs.h"
+#include "framebuffer.h"
+#include "bitmapbase.h"
+#include "stringiterator.h"
+
+using namespace WoopsiUI;
+
+GraphicsPort::GraphicsPort(const s16 x, const s16 y, const u16 width, const u16 height, const bool isEnabled, FrameBuffer* bitmap, const Region* clipRegion, const Rect* clipRect) : _graphics(bitmap, Rect(0, 0, bitmap->getWidth(), bitmap->getHeight())) {
+	_rect.x = x;
+	_rect.y = y;
+	_rect.width = width;
+	_rect.height = height;
+	_isEnabled = isEnabled;
+	
+	_isTopScreen = (y >= TOP_SCREEN_Y_OFFSET) && (SCREEN_COUNT > 1);
+	
+	if (_isTopScreen) {
+		int j = 0;
+		j++;
+	}
+
+	_bitmap = bitmap;
+	
+	// Set up clip rect.  A clip region is referred to rather than copied;
+	// each rect is clipped to the dimensions of the port as it is used.
+	if (clipRect != NULL) {
+		setClipRect(*clipRect);
+	} else {
+		_clipRegion = clipRegion;
+	}
+}
+
+void GraphicsPort::setClipRect(const Rect& clipRect) {
+
+	// Clip rect is clipped to the dimensions of the
+	// GraphicsPort before it is stored.  This means
+	// we eliminate a lot of complexity when drawing - 
+	// we clip to rects, which are guaranteed to be
+	// accurate - rather than trying to clip to both
+	// the rects and the dimensions of the port.
+	_clipRegion = NULL;
+	_clipRect = clipRect;
+	_clipRect.clipToIntersect(_rect);
+}
+
+void GraphicsPort::getClipRect(Rect& rect) const {
+	for (s32 i = 0; i < getClipRectCount(); ++i) {
+		if (!getClipRectAt(i, rect)) continue;
+
+		// The rect is adjusted such that its co-ordinates are relative to the
+		// GraphicsPort before it is returned.  This makes using the rect
+		// to optimise drawing easier.
+		rect.x -= getX();
+		rect.y -= getY();
+		return;
+	}
+
+	rect.x = 0;
+	rect.y = 0;
+	rect.width = 0;
+	rect.height = 0;
+}
+
+void GraphicsPort::getClipRegion(Region& region) const {
+	region.clear();
+
+	Rect rect;
+
+	for (s32 i = 0; i < getClipRectCount(); ++i) {
+		if (getClipRectAt(i, rect)) region.addRect(rect);
+	}
+
+	region.translate(-getX(), -getY());
+}
+
+void GraphicsPort::getClipBounds(Rect& rect) const {
+
+	s32 x1 = 0;
+	s32 y1 = 0;
+	s32 x2 = 0;
+	s32 y2 = 0;
+	bool isEmpty = true;
+
+	Rect clip;
+
+	for (s32 i = 0; i < getClipRectCount(); ++i) {
+		if (!getClipRectAt(i, clip)) continue;
+
+		if (isEmpty || (clip.x < x1)) x1 = clip.x;
+		if (isEmpty || (clip.y < y1)) y1 = clip.y;
+		if (isEmpty || (clip.x + clip.width > x2)) x2 = clip.x + clip.width;
+		if (isEmpty || (clip.y + clip.height > y2)) y2 = clip.y + clip.height;
+
+		isEmpty = false;
+	}
+
+	rect.x = x1 - getX();
+	rect.y = y1 - getY();
+	rect.width = x2 - x1;
+	rect.height = y2 - y1;
+}
+
+bool GraphicsPort::getClipRectAt(s32 index, Rect& rect) const {
+	if (_clipRegion == NULL) {
+		_clipRect.copyTo(rect);
+	} else {
+		_clipRegion->at(index).copyTo(rect);
+		rect.clipToIntersect(_rect);
+	}
+
+	return rect.hasDimensions();
+}
+
+// Print a string in a specific colour
+void GraphicsPort::drawText(s16 x, s16 y, FontBase* font, const WoopsiString& string, s32 startIndex, s32 length, u16 colour) {
+	
+	// Ignore command if drawing is disabled
+	if (!_isEnabled) return;
+
+	drawText(x, y, font, string, startIndex, length, colour, font->getStringWidth(string, startIndex, length));
+}
+
+void GraphicsPort::drawText(s16 x, s16 y, FontBase* font, const WoopsiString& string, s32 startIndex, s32 length, u16 colour, u16 width) {
+	
+	// Ignore command if drawing is disabled
+	if (!_isEnabled) return;
+
+	// Adjust from port-space to screen-space
+	convertPortToScreenSpace(&x, &y);
+	
+	Rect rect;
+	Rect bounds(x, y, width, font->getHeight());
+
+	// Skip to the first clip rect that the text overlaps
+	s32 first = 0;
+	if (!getNextClipRect(first, &bounds, rect)) return;
+
+	// Draw each character into every clip rect that it overlaps, so the
+	// string is only iterated over once however many rects there are
+	StringIterator iterator(&string);
+
+	if (!iterator.moveTo(startIndex)) return;
+
+	s16 portX2 = _rect.x + _rect.width;
+
+	do {
+		u32 codePoint = iterator.getCodePoint();
+		Rect glyph(x, y, font->getCharWidth(codePoint), bounds.height);
+
+		for (s32 i = first; getNextClipRect(i, &glyph, rect); ++i) {
+			font->drawChar(_bitmap, codePoint, colour, x, y, rect.x, rect.y, rect.x + rect.width - 1, rect.y + rect.height - 1);
+		}
+
+		x += glyph.width;
+
+		// Abort if x pos outside port
+		if (x >= portX2) break;
+	} while (iterator.moveToNext() && (iterator.getIndex() < startIndex + length));
+}
+
+// Print a string in a specific colour on a baseline
+void GraphicsPort::drawBaselineText(s16 x, s16 y, FontBase* font, const WoopsiString& string, s32 startIndex, s32 length, u16 colour) {
+	
+	// Ignore command if drawing is disabled
+	if (!_isEnabled) return;
+
+	// Adjust from port-space to screen-space
+	convertPortToScreenSpace(&x, &y);
+	
+	Rect rect;
+
+	// The vertical extent of each character depends on the font, so clip
+	// rects can only be culled horizontally
+	Rect glyph(x, _rect.y, 0, _rect.height);
+
+	if (_isTopScreen) glyph.y -= TOP_SCREEN_Y_OFFSET;
+
+	StringIterator iterator(&string);
+
+	if (!iterator.moveTo(startIndex)) return;
+
+	do {
+		u32 codePoint = iterator.getCodePoint();
+
+		glyph.x = x;
+		glyph.width = font->getCharWidth(codePoint);
+
+		for (s32 i = 0; getNextClipRect(i, &glyph, rect); ++i) {
+			font->drawBaselineChar(_bitmap, codePoint, colour, x, y, rect.x, rect.y, rect.x + rect.width - 1, rect.y + rect.height - 1);
+		}
+
+		x += glyph.width;
+	} while (iterator.moveToNext() && (iterator.getIndex() < startIndex + length));
+}
+
+void GraphicsPort::drawText(s16 x, s16 y, FontBase* font, const WoopsiString& string) {
+	drawText(x, y, font, string, 0, string.getLength());
+}
+
+// Draw filled rectangle - external function
+void GraphicsPort::drawFilledRect(s16 x, s16 y, u16 width, u16 height, u16 colour) {
+	
+	// Ignore command if drawing is disabled
+	if (!_isEnabled) return;
+	
+	// Adjust from port-space to screen-space
+	convertPortToScreenSpace(&x, &y);
+
+	Rect rect;
+	Rect bounds(x, y, width, height);
+
+	// Draw all visible rects that overlap the area being drawn
+	for (s32 i = 0; getNextClipRect(i, &bounds, rect); ++i) {
+		_graphics.setClipRect(rect);
+		_graphics.drawFilledRect(x, y, width, height, colour);
+	}
+}
+
+void GraphicsPort::drawFilledRows(s16 x, s16 y, u16 width, u16 height, const u16* rowColours) {
+	
+	// Ignore command if drawing is disabled
+	if (!_isEnabled) return;
+	
+	// Adjust from port-space to screen-space
+	convertPortToScreenSpace(&x, &y);
+
+	Rect rect;
+	Rect bounds(x, y, width, height);
+
+	// Draw all visible rects that overlap the area being drawn
+	for (s32 i = 0; getNextClipRect(i, &bounds, rect); ++i) {
+		_graphics.setClipRect(rect);
+		_graphics.drawFilledRows(x, y, width, height, rowColours);
+	}
+}
+
+void GraphicsPort::drawEllipse(s16 xCentre, s16 yCentre, s16 horizRadius, s16 vertRadius, u16 colour) {
+	
+	// Ignore command if drawing is disabled
+	if (!_isEnabled) return;
+	
+	// Adjust from port-space to screen-space
+	convertPortToScreenSpace(&xCentre, &yCentre);
+	
+	Rect rect;
+	Rect bounds(xCentre - horizRadius, yCentre - vertRadius, (horizRadius * 2) + 1, (vertRadius * 2) + 1);
+	const Rect* area = ((horizRadius >= 0) && (vertRadius >= 0)) ? &bounds : NULL;
+
+	// Draw all visible rects that overlap the area being drawn
+	for (s32 i = 0; getNextClipRect(i, area, rect); ++i) {
+		_graphics.setClipRect(rect);
+		_graphics.drawEllipse(xCentre, yCentre, horizRadius, vertRadius, colour);
+	}
+}
+
+
+void GraphicsPort::drawFilledEllipse(s16 xCentre, s16 yCentre, s16 horizRadius, s16 vertRadius, u16 colour) {
+	
+	// Ignore command if drawing is disabled
+	if (!_isEnabled) return;
+	
+	// Adjust from port-space to screen-space
+	convertPortToScreenSpace(&xCentre, &yCentre);
+	
+	Rect rect;
+	Rect bounds(xCentre - horizRadius, yCentre - vertRadius, (horizRadius * 2) + 1, (vertRadius * 2) + 1);
+	const Rect* area = ((horizRadius >= 0) && (vertRadius >= 0)) ? &bounds : NULL;
+
+	// Draw all visible rects that overlap the area being drawn
+	for (s32 i = 0; getNextClipRect(i, area, rect); ++i) {
+		_graphics.setClipRect(rect);
+		_graphics.drawFilledEllipse(xCentre, yCentre, horizRadius, vertRadius, colour);
+	}
+}
+
+void GraphicsPort::drawRect(s16 x, s16 y, u16 width, u16 height, u16 colour) {
+	
+	// Ignore command if drawing is disabled
+	if (!_isEnabled) return;
+	
+	// Adjust from port-space to screen-space
+	convertPortToScreenSpace(&x, &y);
+
+	Rect rect;
+	Rect bounds(x, y, width, height);
+
+	// Rects too small to have distinct edges draw outside their bounds, so
+	// they cannot be culled
+	const Rect* area = ((width > 1) && (height > 1)) ? &bounds : NULL;
+
+	// Draw all visible rects that overlap the area being drawn
+	for (s32 i = 0; getNextClipRect(i, area, rect); ++i) {
+		_graphics.setClipRect(rect);
+		_graphics.drawRect(x, y, width, height, colour);
+	}
+}
+
+void GraphicsPort::drawBevelledRect(s16 x, s16 y, u16 width, u16 height, u16 shineColour, u16 shadowColour) {
+	
+	// Ignore command if drawing is disabled
+	if (!_isEnabled) return;
+	
+	// Adjust from port-space to screen-space
+	convertPortToScreenSpace(&x, &y);
+	
+	Rect rect;
+	Rect bounds(x, y, width, height);
+
+	// Rects too small to have distinct edges draw outside their bounds, so
+	// they cannot be culled
+	const Rect* area = ((width > 1) && (height > 1)) ? &bounds : NULL;
+
+	// Draw all visible rects that overlap the area being drawn
+	for (s32 i = 0; getNextClipRect(i, area, rect); ++i) {
+		_graphics.setClipRect(rect);
+		_graphics.drawBevelledRect(x, y, width, height, shineColour, shadowColour);
+	}
+}
+
+void GraphicsPort::drawFilledXORRect(s16 x, s16 y, u16 width, u16 height, u16 colour) {
+	
+	// Ignore command if drawing is disabled
+	if (!_isEnabled) return;
+	
+	// Adjust from port-space to screen-space
+	convertPortToScreenSpace(&x, &y);
+
+	Rect rect;
+	Rect bounds(x, y, width, height);
+
+	// Draw all visible rects that overlap the area being drawn
+	for (s32 i = 0; getNextClipRect(i, &bounds, rect); ++i) {
+		_graphics.setClipRect(rect);
+		_graphics.drawFilledXORRect(x, y, width, height, colour);
+	}
+}
+
+void GraphicsPort::drawFilledXORRect(s16 x, s16 y, u16 width, u16 height) {
+	drawFilledXORRect(x, y, width, height, 0xffff);
+}
+
+void GraphicsPort::drawXORRect(s16 x, s16 y, u16 width, u16 height) {
+	drawXORRect(x, y, width, height, 0xffff);
+}
+
+void GraphicsPort::drawXORRect(s16 x, s16 y, u16 width, u16 height, u16 colour) {
+	
+	// Ignore command if drawing is disabled
+	if (!_isEnabled) return;
+	
+	// Adjust from port-space to screen-space
+	convertPortToScreenSpace(&x, &y);
+
+	Rect rect;
+	Rect bounds(x, y, width, height);
+
+	// Rects too small to have distinct edges draw outside their bounds, so
+	// they cannot be culled
+	const Rect* area = ((width > 1) && (height > 1)) ? &bounds : NULL;
+
+	// Draw all visible rects that overlap the area being drawn
+	for (s32 i = 0; getNextClipRect(i, area, rect); ++i) {
+		_graphics.setClipRect(rect);
+		_graphics.drawXORRect(x, y, width, height, colour);
+	}
+}
+
+//Draw bitmap - external function
+void GraphicsPort::drawBitmap(s16 x, s16 y, u16 width, u16 height, const BitmapBase* bitmap, s16 bitmapX, s16 bitmapY) {
+	
+	// Ignore command if drawing is disabled
+	if (!_isEnabled) return;
+
+	// Adjust from port-space to screen-space
+	convertPortToScreenSpace(&x, &y);
+	
+	Rect rect;
+	Rect bounds(x, y, width, height);
+
+	// Draw all visible rects that overlap the area being drawn
+	for (s32 i = 0; getNextClipRect(i, &bounds, rect); ++i) {
+		_graphics.setClipRect(rect);
+		_graphics.drawBitmap(x, y, width, height, bitmap, bitmapX, bitmapY);
+	}
+}
+
+//Draw bitmap with transparency - external function
+void GraphicsPort::drawBitmap(s16 x, s16 y, u16 width, u16 height, const BitmapBase* bitmap, s16 bitmapX, s16  bitmapY, u16 transparentColour) {
+	
+	// Ignore command if drawing is disabled
+	if (!_isEnabled) return;
+	
+	// Adjust from port-space to screen-space
+	convertPortToScreenSpace(&x, &y);
+	
+	Rect rect;
+	Rect bounds(x, y, width, height);
+
+	// Draw all visible rects that overlap the area being drawn
+	for (s32 i = 0; getNextClipRect(i, &bounds, rect); ++i) {
+		_graphics.setClipRect(rect);
+		_graphics.drawBitmap(x, y, width, height, bitmap, bitmapX, bitmapY, transparentColour);
+	}
+}
+
+void GraphicsPort::drawBitmapGreyScale(s16 x, s16 y, u16 width, u16 height, const BitmapBase* bitmap, s16 bitmapX, s16 bitmapY) {
+	
+	// Ignore command if drawing is disabled
+	if (!_isEnabled) return;
+
+	// Adjust from port-space to screen-space
+	convertPortToScreenSpace(&x, &y);
+
+	Rect rect;
+	Rect bounds(x, y, width, height);
+
+	// Draw all visible rects that overlap the area being drawn
+	for (s32 i = 0; getNextClipRect(i, &bounds, rect); ++i) {
+		_graphics.setClipRect(rect);
+		_graphics.drawBitmapGreyScale(x, y, width, height, bitmap, bitmapX, bitmapY);
+	}
+}
+
+void GraphicsPort::drawXORHorizLine(s16 x, s16 y, u16 width) {
+	drawXORHorizLine(x, y, width, 0xffff);
+}
+
+void GraphicsPort::drawXORHorizLine(s16 x, s16 y, u16 width, u16 colour) {
+	
+	// Ignore command if drawing is disabled
+	if (!_isEnabled) return;
+	
+	// Adjust from port-space to screen-space
+	convertPortToScreenSpace(&x, &y);
+
+	Rect rect;
+	Rect bounds(x, y, width, 1);
+
+	// Draw all visible rects that overlap the area being drawn
+	for (s32 i = 0; getNextClipRect(i, &bounds, rect); ++i) {
+		_graphics.setClipRect(rect);
+		_graphics.drawXORHorizLine(x, y, width, colour);
+	}
+}
+
+void GraphicsPort::drawXORVertLine(s16 x, s16 y, u16 height, u16 colour) {
+	
+	// Ignore command if drawing is disabled
+	if (!_isEnabled) return;
+	
+	// Adjust from port-space to screen-space
+	convertPortToScreenSpace(&x, &y);
+
+	Rect rect;
+	Rect bounds(x, y, 1, height);
+
+	// Draw all visible rects that overlap the area being drawn
+	for (s32 i = 0; getNextClipRect(i, &bounds, rect); ++i) {
+		_graphics.setClipRect(rect);
+		_graphics.drawXORVertLine(x, y, height, colour);
+	}
+}
+
+void GraphicsPort::drawXORVertLine(s16 x, s16 y, u16 height) {
+	drawXORVertLine(x, y, height, 0xffff);
+}
+
+bool GraphicsPort::getNextClipRect(s32& index, const Rect* bounds, Rect& rect) const {
+	s32 count = getClipRectCount();
+
+	for (; index < count; ++index) {
+
+		// The region is banded, so no rects after one that starts below the
+		// port can overlap it
+		if ((_clipRegion != NULL) && (_clipRegion->at(index).y >= _rect.y + _rect.height)) return false;
+
+		if (!getClipRectAt(index, rect)) continue;
+
+		// Adjust from graphicsport co-ordinates to framebuffer co-ordinates
+		if (_isTopScreen) rect.y -= TOP_SCREEN_Y_OFFSET;
+
+		if (bounds != NULL) {
+
+			// The region is banded, so no rects after one that starts below
+			// the bounds can overlap them
+			if (rect.y >= bounds->y + bounds->height) return false;
+
+			if (!rect.intersects(*bounds)) continue;
+		}
+
+		// Ensure that the rect does not exceed the framebuffer dimensions,
+		// as it may be passed directly to a font
+		rect.clipToIntersect(Rect(0, 0, _bitmap->getWidth(), _bitmap->getHeight()));
+
+		if (rect.hasDimensions()) return true;
+	}
+
+	return false;
+}
+
+// Adjust co-ords from port-space to screen-space
+void GraphicsPort::convertPortToScreenSpace(s16* x, s16* y) {
+	*x += getX();
+	*y += getY();
+
+	// Compensate for top screen offset
+	if (_isTopScreen) *y -= TOP_SCREEN_Y_OFFSET;
+}
+
+void GraphicsPort::drawPixel(s16 x, s16 y, u16 colour) {
+	
+	// Ignore command if drawing is disabled
+	if (!_isEnabled) return;
+	
+	// Adjust from port-space to screen-space
+	convertPortToScreenSpace(&x, &y);
+	
+	Rect rect;
+	Rect bounds(x, y, 1, 1);
+
+	// Draw all visible rects that overlap the area being drawn
+	for (s32 i = 0; getNextClipRect(i, &bounds, rect); ++i) {
+		_graphics.setClipRect(rect);
+		_graphics.drawPixel(x, y, colour);
+	}
+}
+
+void GraphicsPort::drawXORPixel(s16 x, s16 y) {
+	drawXORPixel(x, y, 0xffff);
+}
+
+void GraphicsPort::drawXORPixel(s16 x, s16 y, u16 colour) {
+	
+	// Ignore command if drawing is disabled
+	if (!_isEnabled) return;
+	
+	// Adjust from port-space to screen-space
+	convertPortToScreenSpace(&x, &y);
+
+	Rect rect;
+	Rect bounds(x, y, 1, 1);
+
+	// Draw all visible rects that overlap the area being drawn
+	for (s32 i = 0; getNextClipRect(i, &bounds, rect); ++i) {
+		_graphics.setClipRect(rect);
+		_graphics.drawXORPixel(x, y, colour);
+	}
+}
+
+void GraphicsPort::drawLine(s16 x1, s16 y1, s16 x2, s16 y2, u16 colour) {
+	
+	// Ignore command if drawing is disabled
+	if (!_isEnabled) return;
+	
+	// Adjust from port-space to screen-space
+	convertPortToScreenSpace(&x1, &y1);
+	convertPortToScreenSpace(&x2, &y2);
+
+	Rect rect;
+	Rect bounds(x1 < x2 ? x1 : x2, y1 < y2 ? y1 : y2, (x1 < x2 ? x2 - x1 : x1 - x2) + 1, (y1 < y2 ? y2 - y1 : y1 - y2) + 1);
+
+	// Draw all visible rects that overlap the area being drawn
+	for (s32 i = 0; getNextClipRect(i, &bounds, rect); ++i) {
+		_graphics.setClipRect(rect);
+		_graphics.drawLine(x1, y1, x2, y2, colour);
+	}
+}
+
+void GraphicsPort::copy(s16 sourceX, s16 sourceY, s16 destX, s16 destY, u16 width, u16 height) {
+	
+	// Ignore command if drawing is disabled
+	if (!_isEnabled) return;
+
+	// Adjust from port-space to screen-space
+	convertPortToScreenSpace(&sourceX, &sourceY);
+	convertPortToScreenSpace(&destX, &destY);
+
+	Rect rect;
+	Rect bounds(destX, destY, width, height);
+
+	// Draw all visible rects that overlap the area being drawn
+	for (s32 i = 0; getNextClipRect(i, &bounds, rect); ++i) {
+		_graphics.setClipRect(rect);
+		_graphics.copy(sourceX, sourceY, destX, destY, width, height);
+	}
+}
+
+void GraphicsPort::scroll(s16 x, s16 y, s16 xDistance, s16 yDistance, u16 width, u16 height, WoopsiArray<Rect>* revealedRects) {
+	
+	// Ignore command if drawing is disabled
+	if (!_isEnabled) return;
+	
+	// Adjust from port-space to screen-space
+	convertPortToScreenSpace(&x, &y);
+
+	Rect rect;
+	Rect bounds(x, y, width, height);
+
+	// Draw all visible rects that overlap the area being drawn
+	for (s32 i = 0; getNextClipRect(i, &bounds, rect); ++i) {
+		_graphics.setClipRect(rect);
+		_graphics.scroll(x, y, xDistance, yDistance, width, height, revealedRects);
+	}
+	
+	// Adjust revealedRects back to graphicsport space
+	for (s32 i = 0; i < revealedRects->size(); ++i) {
+		revealedRects->at(i).x -= _rect.x;
+		revealedRects->at(i).y -= _rect.y;
+		
+		if (_isTopScreen) revealedRects->at(i).y += TOP_SCREEN_Y_OFFSET;
+	}
+}
+
+void GraphicsPort::dim(s16 x, s16 y, u16 width, u16 height) {
+
+	// Ignore command if drawing is disabled
+	if (!_isEnabled) return;
+	
+	// Adjust from port-space to screen-space
+	convertPortToScreenSpace(&x, &y);
+
+	Rect rect;
+	Rect bounds(x, y, width, height);
+
+	// Draw all visible rects that overlap the area being drawn
+	for (s32 i = 0; getNextClipRect(i, &bounds, rect); ++i) {
+		_graphics.setClipRect(rect);
+		_graphics.dim(x, y, width, height);
+	}
+}
+
+void GraphicsPort::greyScale(s16 x, s16 y, u16 width, u16 height) {
+
+	// Ignore command if drawing is disabled
+	if (!_isEnabled) return;
+	
+	// Adjust from port-space to screen-space
+	convertPortToScreenSpace(&x, &y);
+
+	Rect rect;
+	Rect bounds(x, y, width, height);
+
+	// Draw all visible rects that overlap the area being drawn
+	for (s32 i = 0; getNextClipRect(i, &bounds, rect); ++i) {
+		_graphics.setClipRect(rect);
+		_graphics.greyScale(x, y, width, height);
+	}
+}
@@ -13,9 +13,14 @@ WoopsiUI::Graphics* Hardware::_bottomGfx = NULL;
 
 #ifdef USING_SDL
 
+#ifndef USING_HEADLESS
 SDL_Window* Hardware::_window = NULL;
 SDL_Renderer* Hardware::_renderer = NULL;
 SDL_Texture* Hardware::_texture = NULL;
+Uint32 Hardware::_lastFrameTime = 0;
+bool Hardware::_waitForInput = false;
+bool Hardware::_needsPresent = true;
+#endif
 
 u16* Hardware::_topBitmap = NULL;
 u16* Hardware::_bottomBitmap = NULL;
@@ -44,6 +49,8 @@ void Hardware::init() {
 
 #else
 
+#ifndef USING_HEADLESS
+
 	Uint32 initflags = SDL_INIT_VIDEO;
 
 	// Initialize the SDL library
@@ -61,9 +68,14 @@ void Hardware::init() {
 
     _texture = SDL_CreateTexture(_renderer, SDL_PIXELFORMAT_ABGR1555, SDL_TEXTUREACCESS_STREAMING, SCREEN_WIDTH, SCREEN_HEIGHT * 2);
 
+#endif
+
     _topBitmap = new u16[SCREEN_WIDTH * SCREEN_HEIGHT];
     _bottomBitmap = new u16[SCREEN_WIDTH * SCREEN_HEIGHT];
 
+	memset(_topBitmap, 0, SCREEN_WIDTH * SCREEN_HEIGHT * sizeof(u16));
+	memset(_bottomBitmap, 0, SCREEN_WIDTH * SCREEN_HEIGHT * sizeof(u16));
+
 	_topBuffer = new FrameBuffer(_topBitmap, SCREEN_WIDTH, SCREEN_HEIGHT);
 	_bottomBuffer = new FrameBuffer(_bottomBitmap, SCREEN_WIDTH, SCREEN_HEIGHT);
 
@@ -80,12 +92,14 @@ void Hardware::shutdown() {
 	delete _bottomBuffer;
 	
 #ifdef USING_SDL
+#ifndef USING_HEADLESS
 	SDL_DestroyRenderer(_renderer);
     SDL_DestroyTexture(_texture);
     SDL_DestroyWindow(_window);
+#endif
     
-    delete _topBitmap;
-    delete _bottomBitmap;
+    delete[] _topBitmap;
+    delete[] _bottomBitmap;
 #endif
 }
 
@@ -95,38 +109,35 @@ void Hardware::waitForVBlank() {
 
 	swiWaitForVBlank();
 
-#else
+#elif !defined(USING_HEADLESS)
 
-    SDL_Rect rect;
-    rect.x = 0;
-    rect.y = 0;
-    rect.w = SCREEN_WIDTH;
-    rect.h = SCREEN_HEIGHT;
-	SDL_UpdateTexture(_texture, &rect, _topBitmap, SCREEN_WIDTH * sizeof(u16));
+	// Upload only the parts of each screen that were drawn to
+	bool isDirty = uploadDirtyRect(_topBuffer, 0);
+	if (uploadDirtyRect(_bottomBuffer, SCREEN_HEIGHT)) isDirty = true;
 
-    rect.y = SCREEN_HEIGHT;
-    SDL_UpdateTexture(_texture, &rect, _bottomBitmap, SCREEN_WIDTH * sizeof(u16));
+	SDL_Event event;
 
-    SDL_RenderCopy(_renderer, _texture, NULL, NULL);
-    SDL_RenderPresent(_renderer);
+	if (isDirty || _needsPresent) {
+		SDL_RenderCopy(_renderer, _texture, NULL, NULL);
+		SDL_RenderPresent(_renderer);
+		_needsPresent = false;
+	} else if (_waitForInput) {
+
+		// Nothing changed; sleep until something happens
+		if (SDL_WaitEvent(&event)) handleEvent(event);
+	} else {
+
+		// Nothing changed; skip the present but keep to the frame rate that
+		// the vsynced present would have given us
+		Uint32 elapsed = SDL_GetTicks() - _lastFrameTime;
+		if (elapsed < 16) SDL_Delay(16 - elapsed);
+	}
+
+	_lastFrameTime = SDL_GetTicks();
 
 	// SDL event pump
-	SDL_Event event;
-	
-	// Check for SDL quit
 	while (SDL_PollEvent(&event)) {
-        switch (event.type) {
-            case SDL_QUIT:
-                exit(0);
-				return;
-            case SDL_KEYDOWN:
-                if (event.key.keysym.scancode == 53) {
-                    // Escape pressed
-					exit(0);
-					return;
-                }
-                break;
-        }
+		handleEvent(event);
 	}
 
 #endif
@@ -134,3 +145,63 @@ void Hardware::waitForVBlank() {
 	_pad.update();
 	_stylus.update();
 }
+
+#if defined(USING_SDL) && !defined(USING_HEADLESS)
+
+bool Hardware::uploadDirtyRect(FrameBuffer* buffer, s16 y) {
+	if (!buffer->isDirty()) return false;
+
+	Rect dirty;
+	buffer->getDirtyRect(dirty);
+
+	SDL_Rect rect;
+	rect.x = dirty.x;
+	rect.y = dirty.y + y;
+	rect.w = dirty.width;
+	rect.h = dirty.height;
+
+	SDL_UpdateTexture(_texture, &rect, buffer->getData() + (dirty.y * SCREEN_WIDTH) + dirty.x, SCREEN_WIDTH * sizeof(u16));
+
+	buffer->clearDirtyRect();
+
+	return true;
+}
+
+void Hardware::handleEvent(const SDL_Event& event) {
+	switch (event.type) {
+		case SDL_QUIT:
+			exit(0);
+			return;
+		case SDL_KEYDOWN:
+			if (event.key.keysym.scancode == 53) {
+				// Escape pressed
+				exit(0);
+				return;
+			}
+
+			_pad.latchKey(event.key.keysym.scancode);
+			break;
+		case SDL_MOUSEBUTTONDOWN:
+			if (event.button.button == SDL_BUTTON_LEFT) {
+				_stylus.latchPress();
+				_stylus.addSample(event.button.x, event.button.y - SCREEN_HEIGHT, event.button.timestamp);
+			}
+			break;
+		case SDL_MOUSEMOTION:
+
+			// Record every position the stylus passes through so that
+			// gadgets can follow the whole path, not just where it ended up
+			// at the VBL
+			if (event.motion.state & SDL_BUTTON_LMASK) {
+				_stylus.addSample(event.motion.x, event.motion.y - SCREEN_HEIGHT, event.motion.timestamp);
+			}
+			break;
+		case SDL_WINDOWEVENT:
+			// Window may have been uncovered or resized, so the texture
+			// must be presented again even if nothing has been drawn
+			_needsPresent = true;
+			break;
+	}
+}
+
+#endif
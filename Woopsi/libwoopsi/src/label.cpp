@@ -16,6 +16,9 @@ Label::Label(s16 x, s16 y, u16 width, u16 height, const WoopsiString& text, Gadg
 
 	_textX = 0;
 	_textY = 0;
+	_textWidth = 0;
+	_textWidthFont = NULL;
+	_textWidthGeneration = 0;
 
 	setText(text);
 
@@ -24,10 +27,12 @@ Label::Label(s16 x, s16 y, u16 width, u16 height, const WoopsiString& text, Gadg
 }
 
 void Label::drawContents(GraphicsPort* port) {
+	validateTextPosition();
+
 	if (isEnabled()) {
-		port->drawText(_textX, _textY, getFont(), _text, 0, _text.getLength(), getTextColour());
+		port->drawText(_textX, _textY, getFont(), _text, 0, _text.getLength(), getTextColour(), getTextWidth());
 	} else {
-		port->drawText(_textX, _textY, getFont(), _text, 0, _text.getLength(), getDarkColour());
+		port->drawText(_textX, _textY, getFont(), _text, 0, _text.getLength(), getDarkColour(), getTextWidth());
 	}
 }
 
@@ -65,13 +70,13 @@ void Label::calculateTextPositionHorizontal() {
 	
 	switch (_hAlignment) {
 		case TEXT_ALIGNMENT_HORIZ_CENTRE:
-			_textX = (rect.width - getFont()->getStringWidth(_text)) >> 1;
+			_textX = (rect.width - getTextWidth()) >> 1;
 			break;
 		case TEXT_ALIGNMENT_HORIZ_LEFT:
 			_textX = 0;
 			break;
 		case TEXT_ALIGNMENT_HORIZ_RIGHT:
-			_textX = rect.width - getFont()->getStringWidth(_text);
+			_textX = rect.width - getTextWidth();
 			break;
 	}
 }
@@ -92,15 +97,16 @@ void Label::setTextAlignmentVert(TextAlignmentVert alignment) {
 
 void Label::setText(const WoopsiString& text) {
 
-	u16 oldWidth = getFont()->getStringWidth(_text);
+	u16 oldWidth = getTextWidth();
 	u16 oldX = _textX;
 	u16 oldY = _textY;
 
 	_text.setText(text);
+	invalidateTextWidth();
 
 	calculateTextPositionHorizontal();
 
-	u16 newWidth = getFont()->getStringWidth(_text);
+	u16 newWidth = getTextWidth();
 	u16 newX = _textX;
 	u16 newY = _textY;
 
@@ -119,15 +125,16 @@ void Label::setText(const WoopsiString& text) {
 
 void Label::appendText(const WoopsiString& text) {
 
-	u16 oldWidth = getFont()->getStringWidth(_text);
+	u16 oldWidth = getTextWidth();
 	u16 oldX = _textX;
 	u16 oldY = _textY;
 
 	_text.append(text);
+	invalidateTextWidth();
 
 	calculateTextPositionHorizontal();
 
-	u16 newWidth = getFont()->getStringWidth(_text);
+	u16 newWidth = getTextWidth();
 	u16 newX = _textX;
 	u16 newY = _textY;
 
@@ -146,15 +153,16 @@ void Label::appendText(const WoopsiString& text) {
 
 void Label::insertText(const WoopsiString& text, const u32 index) {
 
-	u16 oldWidth = getFont()->getStringWidth(_text);
+	u16 oldWidth = getTextWidth();
 	u16 oldX = _textX;
 	u16 oldY = _textY;
 
 	_text.insert(text, index);
+	invalidateTextWidth();
 
 	calculateTextPositionHorizontal();
 
-	u16 newWidth = getFont()->getStringWidth(_text);
+	u16 newWidth = getTextWidth();
 	u16 newX = _textX;
 	u16 newY = _textY;
 
@@ -177,6 +185,8 @@ void Label::onResize(u16 width, u16 height) {
 }
 
 void Label::onTextChange() {
+	invalidateTextWidth();
+
 	calculateTextPositionHorizontal();
 	calculateTextPositionVertical();
 
@@ -197,7 +207,7 @@ void Label::getPreferredDimensions(Rect& rect) const {
 		rect.height = _borderSize.top + _borderSize.bottom;
 	}
 
-	rect.width += getFont()->getStringWidth(_text);
+	rect.width += getTextWidth();
 	rect.height += getFont()->getHeight();
 }
 
@@ -220,6 +230,19 @@ void Label::setBorderless(bool isBorderless) {
 	markRectsDamaged();
 }
 
+const u16 Label::getTextWidth() const {
+
+	// Remeasure the text if it has changed, the font has been swapped or the
+	// font's character widths have changed
+	if (!isTextWidthValid()) {
+		_textWidth = getFont()->getStringWidth(_text);
+		_textWidthFont = getFont();
+		_textWidthGeneration = getFont()->getWidthGeneration();
+	}
+
+	return _textWidth;
+}
+
 void Label::markTextRectDamaged() {
 
 	Rect textRect;
@@ -43,7 +43,7 @@ void ListBox::drawContents(GraphicsPort* port) {
 	port->drawFilledRect(0, 0, getWidth(), getHeight(), getBackColour());
 
 	Rect rect;
-	port->getClipRect(rect);
+	port->getClipBounds(rect);
 
 	// Calculate clipping values
 	s16 clipX = rect.x;
@@ -89,9 +89,9 @@ void ListBox::drawContents(GraphicsPort* port) {
 		
 			// Draw text
 			if (isEnabled()) {
-				port->drawText(_optionPadding, y + _optionPadding, getFont(), item->getText(), 0, item->getText().getLength(), item->getSelectedTextColour());
+				port->drawText(_optionPadding, y + _optionPadding, getFont(), item->getText(), 0, item->getText().getLength(), item->getSelectedTextColour(), item->getTextWidth(getFont()));
 			} else {
-				port->drawText(_optionPadding, y + _optionPadding, getFont(), item->getText(), 0, item->getText().getLength(), getDarkColour());
+				port->drawText(_optionPadding, y + _optionPadding, getFont(), item->getText(), 0, item->getText().getLength(), getDarkColour(), item->getTextWidth(getFont()));
 			}
 		} else {
 			
@@ -102,9 +102,9 @@ void ListBox::drawContents(GraphicsPort* port) {
 			
 			// Draw text
 			if (isEnabled()) {
-				port->drawText(_optionPadding, y + _optionPadding, getFont(), item->getText(), 0, item->getText().getLength(), item->getNormalTextColour());
+				port->drawText(_optionPadding, y + _optionPadding, getFont(), item->getText(), 0, item->getText().getLength(), item->getNormalTextColour(), item->getTextWidth(getFont()));
 			} else {
-				port->drawText(_optionPadding, y + _optionPadding, getFont(), item->getText(), 0, item->getText().getLength(), getDarkColour());
+				port->drawText(_optionPadding, y + _optionPadding, getFont(), item->getText(), 0, item->getText().getLength(), getDarkColour(), item->getTextWidth(getFont()));
 			}
 		}
 		
@@ -283,7 +283,7 @@ void ListBox::getPreferredDimensions(Rect& rect) const {
 
 	// Locate longest string in options
 	for (s32 i = 0; i < _options.getItemCount(); ++i) {
-		optionWidth = getFont()->getStringWidth(_options.getItem(i)->getText());
+		optionWidth = _options.getItem(i)->getTextWidth(getFont());
 
 		if (optionWidth > maxWidth) {
 			maxWidth = optionWidth;
@@ -6,6 +6,10 @@ using namespace WoopsiUI;
 ListData::ListData() {
 	_allowMultipleSelections = true;
 	_sortInsertedItems = false;
+	_updateDepth = 0;
+	_isSortPending = false;
+	_isDataChangedPending = false;
+	_isSelectionChangedPending = false;
 }
 
 ListData::~ListData() {
@@ -21,7 +25,12 @@ ListData::~ListData() {
 void ListData::addItem(ListDataItem* item) {
 
 	// Determine insert type
-	if (_sortInsertedItems) {
+	if (_sortInsertedItems && (_updateDepth > 0)) {
+
+		// Append and sort everything in one go when the update ends
+		_items.push_back(item);
+		_isSortPending = true;
+	} else if (_sortInsertedItems) {
 		
 		// Sorted insert
 		_items.insert(getSortedInsertionIndex(item), item);
@@ -34,6 +43,37 @@ void ListData::addItem(ListDataItem* item) {
 	raiseDataChangedEvent();
 }
 
+void ListData::beginUpdate() {
+	++_updateDepth;
+}
+
+void ListData::endUpdate() {
+
+	if (_updateDepth == 0) return;
+
+	--_updateDepth;
+
+	if (_updateDepth > 0) return;
+
+	if (_isSortPending) {
+		_isSortPending = false;
+
+		mergeSort();
+	}
+
+	if (_isDataChangedPending) {
+		_isDataChangedPending = false;
+
+		raiseDataChangedEvent();
+	}
+
+	if (_isSelectionChangedPending) {
+		_isSelectionChangedPending = false;
+
+		raiseSelectionChangedEvent();
+	}
+}
+
 void ListData::addItem(const WoopsiString& text, const u32 value) {
 	
 	// Create new option
@@ -125,32 +165,69 @@ void ListData::selectAllItems() {
 }
 
 void ListData::sort() {
-	quickSort(0, _items.size() - 1);
+
+	// A full sort makes any pending sort redundant
+	_isSortPending = false;
+
+	mergeSort();
 	
 	raiseDataChangedEvent();
 }
 
-void ListData::quickSort(const s32 start, const s32 end) {
-	if (end > start) {
+void ListData::mergeSort() {
+
+	s32 count = _items.size();
 
-		int left = start;
-		int right = end;
+	if (count < 2) return;
 
-		ListDataItem* pivot = _items[(start + end) >> 1];
+	// Sort runs of increasing width from the bottom up, merging pairs of
+	// sorted runs from the items into the scratch array and back again
+	WoopsiArray<ListDataItem*> scratch;
+	scratch.reserve(count);
 
-		do {
-			while ((pivot->compareTo(_items[left]) > 0) && (left < end)) left++;
-			while ((pivot->compareTo(_items[right]) < 0) && (right > start)) right--;
+	for (s32 i = 0; i < count; ++i) {
+		scratch.push_back(NULL);
+	}
 
-			if (left > right) break;
+	ListDataItem** source = &_items[0];
+	ListDataItem** dest = &scratch[0];
+
+	for (s32 width = 1; width < count; width <<= 1) {
+		for (s32 left = 0; left < count; left += width << 1) {
+			s32 middle = left + width < count ? left + width : count;
+			s32 right = middle + width < count ? middle + width : count;
+
+			s32 i = left;
+			s32 j = middle;
+			s32 k = left;
+
+			// Runs that are already in order just need copying
+			if ((j < right) && (source[j - 1]->compareTo(source[j]) > 0)) {
+				while ((i < middle) && (j < right)) {
+
+					// Take from the left run on ties to keep the sort stable
+					if (source[j]->compareTo(source[i]) < 0) {
+						dest[k++] = source[j++];
+					} else {
+						dest[k++] = source[i++];
+					}
+				}
+			}
+
+			while (i < middle) dest[k++] = source[i++];
+			while (j < right) dest[k++] = source[j++];
+		}
 
-			swapItems(left, right);
-			left++;
-			right--;
-		} while (left <= right);
+		ListDataItem** tmp = source;
+		source = dest;
+		dest = tmp;
+	}
 
-		quickSort(start, right);
-		quickSort(left, end);
+	// Copy the result back if the last pass left it in the scratch array
+	if (source != &_items[0]) {
+		for (s32 i = 0; i < count; ++i) {
+			_items[i] = source[i];
+		}
 	}
 }
 
@@ -174,20 +251,37 @@ void ListData::removeAllItems() {
 
 const s32 ListData::getSortedInsertionIndex(const ListDataItem* item) const {
 
-	s32 i = 0;
+	s32 low = 0;
+	s32 high = _items.size();
 
-	// Locate slot where new option should go
-	while ((i < _items.size()) && (item->compareTo(_items[i]) > 0)) {
-		i++;
+	// Locate the first item that the new item does not sort after
+	while (low < high) {
+		s32 middle = (low + high) >> 1;
+
+		if (item->compareTo(_items[middle]) > 0) {
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
 	}
 
-	return i;
+	return low;
 }
 
 void ListData::raiseDataChangedEvent() {
+	if (_updateDepth > 0) {
+		_isDataChangedPending = true;
+		return;
+	}
+
 	_listDataEventHandler->handleListDataChangedEvent(*this);
 }
 
 void ListData::raiseSelectionChangedEvent() {
+	if (_updateDepth > 0) {
+		_isSelectionChangedPending = true;
+		return;
+	}
+
 	_listDataEventHandler->handleListDataSelectionChangedEvent(*this);
 }
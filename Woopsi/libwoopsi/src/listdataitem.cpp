@@ -1,4 +1,5 @@
 #include "listdataitem.h"
+#include "fontbase.h"
 
 using namespace WoopsiUI;
 
@@ -7,11 +8,24 @@ ListDataItem::ListDataItem(const WoopsiString& text, const u32 value) {
 	_text = text;
 	_value = value;
 	_isSelected = false;
+	_textWidth = 0;
+	_textWidthFont = NULL;
+	_textWidthGeneration = 0;
 }
 
 ListDataItem::~ListDataItem() {
 }
 
+const u16 ListDataItem::getTextWidth(const FontBase* font) const {
+	if ((_textWidthFont != font) || (_textWidthGeneration != font->getWidthGeneration())) {
+		_textWidth = font->getStringWidth(_text);
+		_textWidthFont = font;
+		_textWidthGeneration = font->getWidthGeneration();
+	}
+
+	return _textWidth;
+}
+
 s8 ListDataItem::compareTo(const ListDataItem* item) const {
 	return _text.compareTo(item->getText());
 }
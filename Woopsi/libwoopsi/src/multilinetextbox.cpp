@@ -31,6 +31,19 @@ MultiLineTextBox::MultiLineTextBox(s16 x, s16 y, u16 width, u16 height, const Wo
 	_flags.doubleClickable = true;
 	_maxRows = maxRows;
 
+	// Text that is not limited to a number of rows can be arbitrarily long,
+	// so wrap it as it is needed
+	_document->setLazyWrapping(_maxRows == -1);
+
+	// Only lazily-wrapped documents need wrapping in the background
+	if (_maxRows == -1) {
+		_wrapTimer = new WoopsiTimer(1, true);
+		addGadget(_wrapTimer);
+		_wrapTimer->setGadgetEventHandler(this);
+	} else {
+		_wrapTimer = NULL;
+	}
+
 	calculateVisibleRows();
 
 	// Set maximum rows if value not set
@@ -44,17 +57,21 @@ MultiLineTextBox::MultiLineTextBox(s16 x, s16 y, u16 width, u16 height, const Wo
 	setText(text);
 }
 
-void MultiLineTextBox::drawText(GraphicsPort* port) {
+void MultiLineTextBox::drawText(GraphicsPort* port, const Rect& rect) {
 
 	// Early exit if there is no text to display
 	if (_document->getLineCount() == 0) return;
 
-	// Determine the top and bottom rows within the graphicsport's clip rect.
-	// We only draw these rows in order to increase the speed of the routine.
-	Rect rect;
-	port->getClipRect(rect);
-
+	// Determine the top and bottom rows within the rect.  We only draw these
+	// rows in order to increase the speed of the routine.
 	s32 regionY = -_canvasY + rect.y;						// Y co-ord of the visible region of this canvas
+
+	// If the text is still being wrapped in the background, ensure that the
+	// visible rows and the page below them have been wrapped
+	if (!_document->isWrapped()) {
+		_document->wrapToLine(((regionY + rect.height) / _document->getLineHeight()) + _visibleRows);
+	}
+
 	s32 topRow = getRowContainingCoordinate(regionY);
 	s32 bottomRow = getRowContainingCoordinate(regionY + rect.height);
 
@@ -91,7 +108,10 @@ void MultiLineTextBox::drawRow(GraphicsPort* port, s32 row) {
 
 void MultiLineTextBox::drawContents(GraphicsPort* port) {
 
-	drawText(port);
+	Rect rect;
+	port->getClipBounds(rect);
+
+	drawText(port, rect);
 
 	// Draw the cursor
 	drawCursor(port);
@@ -117,22 +137,21 @@ void MultiLineTextBox::getCursorCoordinates(s16& x, s16& y) const {
 	// Only calculate the cursor position if the cursor isn't at the start of the text
 	if (_cursorPos > 0) {
 
+		// Ensure that the row containing the cursor has been wrapped
+		while ((!_document->isWrapped()) && (_document->getLineStartIndex(_document->getLineCount()) <= _cursorPos)) {
+			_document->wrapLines(DOCUMENT_LAZY_WRAP_LINES);
+		}
+
 		// Calculate the row in which the cursor appears
 		cursorRow = _document->getLineContainingCharIndex(_cursorPos);
 
 		// Cursor line offset gives us the distance of the cursor from the start of the line
 		u8 cursorLineOffset = _cursorPos - _document->getLineStartIndex(cursorRow);
 			
-		StringIterator* iterator = _document->getText().newStringIterator();
-		iterator->moveTo(_document->getLineStartIndex(cursorRow));
-			
 		// Sum the width of each char in the row to find the x co-ord
-		for (s32 i = 0; i < cursorLineOffset; ++i) {
-			x += getFont()->getCharWidth(iterator->getCodePoint());
-			iterator->moveToNext();
+		if (cursorLineOffset > 0) {
+			x += getFont()->getStringWidth(_document->getText(), _document->getLineStartIndex(cursorRow), cursorLineOffset);
 		}
-			
-		delete iterator;
 	}
 
 	// Add offset of row to calculated value
@@ -194,9 +213,9 @@ u8 MultiLineTextBox::getRowX(s32 row) const {
 
 s16 MultiLineTextBox::getRowY(s32 row) const {
 
-	// If the amount of text exceeds the size of the gadget, force
-	// the text to be top-aligned
-	if (_visibleRows <= _document->getLineCount()) {
+	// If the amount of text exceeds the size of the gadget, or the text is
+	// still being wrapped, force the text to be top-aligned
+	if ((!_document->isWrapped()) || (_visibleRows <= _document->getLineCount())) {
 		return row * _document->getLineHeight();
 	}
 
@@ -298,6 +317,34 @@ void MultiLineTextBox::jumpToTextBottom() {
 	jump(0, -(_canvasHeight - rect.height));
 }
 
+void MultiLineTextBox::wrapInBackground() {
+	if (_wrapTimer == NULL) return;
+	if (!_document->isWrapped()) _wrapTimer->start();
+}
+
+void MultiLineTextBox::handleActionEvent(Gadget& source) {
+
+	if (&source != _wrapTimer) return;
+
+	s32 canvasHeight = _canvasHeight;
+
+	if (_document->wrapLines(DOCUMENT_LAZY_WRAP_LINES)) {
+		_wrapTimer->stop();
+
+		// Text that fits within the textbox is no longer forced to the top
+		// once it has been wrapped
+		if (_document->getLineCount() < _visibleRows) markRectsDamaged();
+	}
+
+	// Fit the canvas to the latest estimate of the height of the text
+	limitCanvasHeight();
+	limitCanvasY();
+
+	if ((_canvasHeight != canvasHeight) && (raisesEvents())) {
+		_gadgetEventHandler->handleActionEvent(*this);
+	}
+}
+
 void MultiLineTextBox::jumpToCursor() {
 
 	// Get the co-odinates of the cursor
@@ -334,7 +381,16 @@ void MultiLineTextBox::setText(const WoopsiString& text) {
 
 	cullTopLines();
 	limitCanvasHeight();
-	jumpToTextBottom();
+
+	// Jumping to the bottom of text that has not been wrapped would force
+	// all of it to be wrapped, so show it from the top instead
+	if (_document->isWrapped()) {
+		jumpToTextBottom();
+	} else {
+		jump(0, 0);
+	}
+
+	wrapInBackground();
 
 	markRectsDamaged();
 
@@ -349,7 +405,10 @@ void MultiLineTextBox::appendText(const WoopsiString& text) {
 
 	cullTopLines();
 	limitCanvasHeight();
-	jumpToTextBottom();
+
+	if (_document->isWrapped()) jumpToTextBottom();
+
+	wrapInBackground();
 
 	markRectsDamaged();
 
@@ -368,6 +427,7 @@ void MultiLineTextBox::removeText(const u32 startIndex, const u32 count) {
 
 	limitCanvasHeight();
 	limitCanvasY();
+	wrapInBackground();
 
 	moveCursorToPosition(startIndex);
 
@@ -384,6 +444,7 @@ void MultiLineTextBox::insertText(const WoopsiString& text, const u32 index) {
 
 	cullTopLines();
 	limitCanvasHeight();
+	wrapInBackground();
 
 	moveCursorToPosition(index + text.getLength());
 
@@ -402,6 +463,7 @@ void MultiLineTextBox::setFont(FontBase* font) {
 	cullTopLines();
 	limitCanvasHeight();
 	limitCanvasY();
+	wrapInBackground();
 
 	markRectsDamaged();
 
@@ -412,7 +474,7 @@ void MultiLineTextBox::setFont(FontBase* font) {
 
 const u16 MultiLineTextBox::getPageCount() const {
 	if (_visibleRows > 0) {
-		return (_document->getLineCount() / _visibleRows) + 1;
+		return (_document->getEstimatedLineCount() / _visibleRows) + 1;
 	} else {
 		return 1;
 	}
@@ -448,11 +510,11 @@ void MultiLineTextBox::onResize(u16 width, u16 height) {
 
 	// Re-wrap the text
 	_document->setWidth(getWidth());
-	_document->wrap();
 
 	bool raiseEvent = cullTopLines() && raisesEvents();
 	limitCanvasHeight();
 	limitCanvasY();
+	wrapInBackground();
 
 	if (raiseEvent) _gadgetEventHandler->handleValueChangeEvent(*this);
 }
@@ -624,33 +686,19 @@ void MultiLineTextBox::processKey(const WoopsiKey& key) {
 
 s32 MultiLineTextBox::getRowContainingCoordinate(s16 y) const {
 
-	s32 row = -1;
-
-	// Locate the row containing the character
-	for (s32 i = 0; i < _document->getLineCount(); ++i) {
+	if (_document->getLineCount() == 0) return -1;
 
-		// Abort search if we've found the row below the y co-ordinate
-		if (getRowY(i) > y) {
+	// Rows are evenly spaced, so the row can be calculated from the offset
+	// of the co-ordinate from the top row
+	s32 offset = y - getRowY(0);
 
-			if (i == 0) {
+	// If the co-ordinate is above the text, we return the top row
+	if (offset < 0) return 0;
 
-				// If the co-ordinate is above the text, we return the top
-				// row
-				row = 0;
-			} else {
-
-				// Row within the text, so return the previous row - this is
-				// the row that contains the co-ordinate.
-				row = i - 1;
-			}
-
-			break;
-		}
-	}
+	s32 row = offset / _document->getLineHeight();
 
-	// If the co-ordinate is below the text, row will still be -1.
-	// We need to set it to the last row
-	if (row == -1) row = _document->getLineCount() - 1;
+	// If the co-ordinate is below the text, we return the last row
+	if (row >= _document->getLineCount()) row = _document->getLineCount() - 1;
 
 	return row;
 }
@@ -660,38 +708,15 @@ u32 MultiLineTextBox::getCharIndexAtCoordinate(s16 x, s32 rowIndex) const {
 	// Locate the character within the row
 	s32 startIndex = _document->getLineStartIndex(rowIndex);
 	s32 stopIndex = _document->getLineLength(rowIndex);
-	s32 width = getRowX(rowIndex);
 	s32 index = -1;
 
-	StringIterator* iterator = _document->getText().newStringIterator();
-	iterator->moveTo(startIndex);
-
-	width += _document->getFont()->getCharWidth(iterator->getCodePoint());
-
-	for (s32 i = 0; i < stopIndex; ++i) {
-		if (width > x) {
-
-			if (i == 0) {
-
-				// If the co-ordinate is on the left of the text, we add nothing
-				// to the index
-				index = startIndex;
-			} else {
-
-				// Character within the row.
-				// This is the character that contains the co-ordinate.
-				index = startIndex + i;
-			}
-
-			break;
-		}
-
-		iterator->moveToNext();
-
-		width += _document->getFont()->getCharWidth(iterator->getCodePoint());
-	}
+	// Find the number of characters that fit to the left of the
+	// co-ordinate; the character after them contains the co-ordinate.  If
+	// the co-ordinate is on the left of the text no characters fit
+	FontBase::TextRun run;
+	_document->getFont()->measureRun(_document->getText(), startIndex, stopIndex, x - getRowX(rowIndex), run);
 
-	delete iterator;
+	if (run.length < stopIndex) index = startIndex + run.length;
 
 	// If the co-ordinate is past the last character, index will still be -1.
 	// We need to set it to the last character
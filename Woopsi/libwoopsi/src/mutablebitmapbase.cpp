@@ -0,0 +1,63 @@
+#include "mutablebitmapbase.h"
+#include "dmafuncs.h"
+#include "rect.h"
+
+using namespace WoopsiUI;
+
+bool MutableBitmapBase::clipToBitmap(u16 bitmapWidth, u16 bitmapHeight, s16 x, s16 y, u16 width, u16 height, Rect& rect) {
+	s32 x1 = x > 0 ? x : 0;
+	s32 y1 = y > 0 ? y : 0;
+	s32 x2 = x + width < bitmapWidth ? x + width : bitmapWidth;
+	s32 y2 = y + height < bitmapHeight ? y + height : bitmapHeight;
+
+	if ((x2 <= x1) || (y2 <= y1)) return false;
+
+	rect.x = x1;
+	rect.y = y1;
+	rect.width = x2 - x1;
+	rect.height = y2 - y1;
+
+	return true;
+}
+
+void MutableBitmapBase::fillData(u16* data, u16 bitmapWidth, const Rect& rect, const u16 colour) {
+	u32 rowWidth = rect.width;
+	u32 rows = rect.height;
+	u16* pos = data + (rect.y * bitmapWidth) + rect.x;
+
+	if (rowWidth == 1) {
+
+		// Vertical line - step down the column
+		while (rows--) {
+			*pos = colour;
+			pos += bitmapWidth;
+		}
+	} else if (rowWidth == bitmapWidth) {
+
+		// Rows are contiguous so the region can be filled in one go
+		woopsiDmaFill(colour, pos, rowWidth * rows);
+	} else {
+		while (rows--) {
+			woopsiDmaFill(colour, pos, rowWidth);
+			pos += bitmapWidth;
+		}
+	}
+}
+
+void MutableBitmapBase::xorData(u16* data, u16 bitmapWidth, const Rect& rect, const u16 colour) {
+	u32 rowWidth = rect.width;
+	u32 rows = rect.height;
+	u16* row = data + (rect.y * bitmapWidth) + rect.x;
+
+	while (rows--) {
+		u16* pos = row;
+		u16* end = row + rowWidth;
+
+		while (pos < end) {
+			*pos = (*pos ^ colour) | (1 << 15);
+			++pos;
+		}
+
+		row += bitmapWidth;
+	}
+}
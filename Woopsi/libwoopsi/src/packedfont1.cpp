@@ -5,6 +5,7 @@ using namespace WoopsiUI;
 
 void PackedFont1::renderChar(
 		const u16* pixelData, u16 pixelsPerRow,
+		const GlyphSpan* spans, u16 spanCount,
 		MutableBitmapBase* bitmap,
 		u16 colour,
 		s16 x, s16 y,
@@ -18,57 +19,65 @@ void PackedFont1::renderChar(
 
 	// If no colour is specified, default to black
 	if (!colour) colour = 1 << 15;
-	
-	u16 curr;
-	u16 mask;
-
-	// adjust clipY2 to be the last row in the glyph
-	// so we only write while (y=<clipY2)
-	if (clipY2 > y + getHeight() - 1) {
-		clipY2 = y + getHeight() - 1;
+
+	s32 x1;
+	s32 x2;
+
+	// Spans are sorted by row, so we can stop as soon as we pass the bottom
+	// of the clipping rectangle
+	for (u16 i = 0; i < spanCount; ++i) {
+		s32 rowY = y + spans[i].y;
+
+		if (rowY < clipY1) continue;
+		if (rowY > clipY2) break;
+
+		if (clipSpan(spans[i], x, clipX1, clipX2, x1, x2)) {
+			bitmap->fillRect(x1, rowY, x2 - x1 + 1, 1, colour);
+		}
 	}
+}
+
+void PackedFont1::createGlyphSpans(const u16* pixelData, u16 pixelsPerRow, WoopsiArray<GlyphSpan>* spans) const {
 
 	// setting mask to 0 forces read of next word. setting curr
 	// avoids a compiler warning.
-	mask = 0;
-	curr = 0;
-
-	// skip over font data corresponding to pixels ABOVE
-	// the clipping rectangle.
-	if (y < clipY1) {
-		u16 rowsToSkip = clipY1-y;
-		u16 pixelsToSkip = rowsToSkip * pixelsPerRow;
-		u16 bitsToSkip = pixelsToSkip & 15;
-		y = clipY1;
-		pixelData += pixelsToSkip / 16;		// skip over a bunch of u16s
-		if (bitsToSkip) {
-			curr = *pixelData++;
-			mask = 0x8000 >> bitsToSkip;
-		}
-	}
+	u16 mask = 0;
+	u16 curr = 0;
+
+	GlyphSpan span;
+
+	// Rows are packed back-to-back, so a row can start part-way through a
+	// u16
+	for (u16 row = 0; row < getHeight(); ++row) {
+		s16 start = -1;
+
+		for (u16 rowX = 0; rowX < pixelsPerRow; ++rowX) {
 
-	while (y <= clipY2) {
-		u16 rowCount = pixelsPerRow;
-		u16 rowX = x;
-		while (rowCount-- > 0) {
 			// if we have runout, get next chunk
 			if (!mask) {
 				mask = 0x8000;
 				curr = *pixelData++;
 			}
 
-			// unpack next pixel
 			if (curr & mask) {
-				// if we need to, write it to the bitmap
-				if (
-					rowX >= clipX1 && rowX <= clipX2	// not clipped X-wise
-				) {
-					bitmap->setPixel(rowX, y, colour);
-				}
+				if (start < 0) start = rowX;
+			} else if (start > -1) {
+				span.x = start;
+				span.y = row;
+				span.width = rowX - start;
+				spans->push_back(span);
+				start = -1;
 			}
+
 			mask >>= 1;
-			rowX++;
 		}
-		y++;
+
+		// Close any run that reaches the right edge of the glyph
+		if (start > -1) {
+			span.x = start;
+			span.y = row;
+			span.width = pixelsPerRow - start;
+			spans->push_back(span);
+		}
 	}
 }
@@ -9,6 +9,7 @@ using namespace WoopsiUI;
 //
 void PackedFont16::renderChar(
 		const u16* pixelData, u16 pixelsPerRow,
+		const GlyphSpan* spans, u16 spanCount,
 		MutableBitmapBase* bitmap,
 		u16 colour,
 		s16 x, s16 y,
@@ -21,41 +22,60 @@ void PackedFont16::renderChar(
 		(x > clipX2) ||
 		(x + pixelsPerRow - 1 < clipX1)) return;
 
-	// adjust clipY2 to be the last row+1 in the glyph
-	// so we only write while (y<=clipY2)
-	if (clipY2 > y + getHeight() - 1) {
-		clipY2 = y + getHeight() - 1;
+	// Copying the font's own colours bypasses the bitmap's clipping, so clip
+	// to the bitmap here
+	if (!colour) {
+		if (clipX2 >= bitmap->getWidth()) clipX2 = bitmap->getWidth() - 1;
+		if (clipY2 >= bitmap->getHeight()) clipY2 = bitmap->getHeight() - 1;
 	}
 
-	// skip over font data corresponding to pixels ABOVE
-	// the clipping rectangle.
-	if (y < clipY1) {
-		u16 rowsToSkip = clipY1 - y;
-		u16 pixelsToSkip = rowsToSkip * pixelsPerRow;
-		y = clipY1;
-		pixelData += pixelsToSkip;
+	s32 x1;
+	s32 x2;
+
+	// Spans are sorted by row, so we can stop as soon as we pass the bottom
+	// of the clipping rectangle
+	for (u16 i = 0; i < spanCount; ++i) {
+		s32 rowY = y + spans[i].y;
+
+		if (rowY < clipY1) continue;
+		if (rowY > clipY2) break;
+
+		if (!clipSpan(spans[i], x, clipX1, clipX2, x1, x2)) continue;
+
+		if (colour) {
+			bitmap->fillRect(x1, rowY, x2 - x1 + 1, 1, colour);
+		} else {
+			bitmap->blit(x1, rowY, pixelData + (spans[i].y * pixelsPerRow) + (x1 - x), x2 - x1 + 1);
+		}
 	}
+}
+
+void PackedFont16::createGlyphSpans(const u16* pixelData, u16 pixelsPerRow, WoopsiArray<GlyphSpan>* spans) const {
+
+	GlyphSpan span;
 
-	// now output pixels till we reach the end
-	while (y <= clipY2) {
-		// get pointer to next row in output
-		u16 rowCount = pixelsPerRow;
-		u16 rowX = x;
-		while (rowCount-- > 0) {
-			// get next pixel
-			u16 pixel = *pixelData++;
-			// if we need to, write it to the bitmap
-			if (
-				pixel				// non-transparent pixel
-				&&
-				rowX >= clipX1 && rowX <= clipX2	// not clipped X-wise
-			) {
-				bitmap->setPixel(rowX, y, colour ? colour : pixel);
+	// Pixels with a value of 0 are transparent
+	for (u16 row = 0; row < getHeight(); ++row) {
+		s16 start = -1;
+
+		for (u16 rowX = 0; rowX < pixelsPerRow; ++rowX) {
+			if (*pixelData++) {
+				if (start < 0) start = rowX;
+			} else if (start > -1) {
+				span.x = start;
+				span.y = row;
+				span.width = rowX - start;
+				spans->push_back(span);
+				start = -1;
 			}
-			rowX++;
 		}
 
-		// move output pointer down one row
-		y++;
+		// Close any run that reaches the right edge of the glyph
+		if (start > -1) {
+			span.x = start;
+			span.y = row;
+			span.width = pixelsPerRow - start;
+			spans->push_back(span);
+		}
 	}
 }
@@ -5,10 +5,20 @@
 
 using namespace WoopsiUI;
 
+PackedFontBase::~PackedFontBase() {
+	delete _glyphSpans;
+	delete[] _glyphSpanStart;
+	delete[] _glyphSpanCount;
+	delete[] _advances;
+}
+
 u8 PackedFontBase::getCharWidth(u32 letter) const {
 	if (_fontWidth) return _fontWidth;
 
+	// Characters without glyph data are drawn as spaces
 	if (letter < _first || letter > _last) return _spWidth;
+	if (_glyphWidth[letter - _first] == 0) return _spWidth;
+
 	return _glyphWidth[letter - _first] + 1;
 }
 
@@ -26,19 +36,44 @@ u16 PackedFontBase::getStringWidth(const WoopsiString& text, s32 startIndex, s32
 
 	u16 total = 0;
 
-	StringIterator* iterator = text.newStringIterator();
-	if (iterator->moveTo(startIndex)) {
+	const u8* advances = getAdvances();
+	u32 count = _last - _first + 1;
+
+	StringIterator iterator(&text);
+	if (iterator.moveTo(startIndex)) {
 	
 		do {
-			total += getCharWidth(iterator->getCodePoint());
-		} while (iterator->moveToNext() && (iterator->getIndex() < startIndex + length));
+			u32 index = iterator.getCodePoint() - _first;
+			total += index < count ? advances[index] : _spWidth;
+		} while (iterator.moveToNext() && (iterator.getIndex() < startIndex + length));
 	}
 
-	delete iterator;
-
 	return total;
 }
 
+const u8* PackedFontBase::getAdvanceTable(u32& first, u32& count, u8& defaultWidth) const {
+	first = _first;
+	count = _last - _first + 1;
+	defaultWidth = _fontWidth ? _fontWidth : _spWidth;
+
+	return getAdvances();
+}
+
+const u8* PackedFontBase::getAdvances() const {
+
+	if (_advances == NULL) {
+		s32 count = _last - _first + 1;
+
+		_advances = new u8[count];
+
+		for (s32 i = 0; i < count; ++i) {
+			_advances[i] = getCharWidth(_first + i);
+		}
+	}
+
+	return _advances;
+}
+
 s16 PackedFontBase::drawChar(
 	MutableBitmapBase* bitmap,
 	u32 letter,
@@ -48,20 +83,24 @@ s16 PackedFontBase::drawChar(
 {
 	// if there is no glyphdata for this letter, just advance by a space
 	if (letter < _first || letter > _last) {
-		return x + _spWidth;
+		return x + getCharWidth(letter);
 	}
 
 	// check what its pixel width is - zero means no such character so
 	// fall back on the width of a space
 	u16 pixelWidth = _glyphWidth[letter - _first];
 	if (pixelWidth == 0) {
-		return x + _spWidth;
+		return x + getCharWidth(letter);
 	}
 
+	u16 spanCount;
+	const GlyphSpan* spans = getGlyphSpans(letter, spanCount);
+
 	// pass off to a subclass for rendering
 	renderChar(
 		&_glyphData[_glyphOffset[letter - _first]],
 		pixelWidth,
+		spans, spanCount,
 		bitmap,
 		colour,
 		x, y,
@@ -69,3 +108,38 @@ s16 PackedFontBase::drawChar(
 
 	return x + getCharWidth(letter);
 }
+
+const PackedFontBase::GlyphSpan* PackedFontBase::getGlyphSpans(u32 letter, u16& count) {
+
+	// Span data is only allocated for fonts that are actually drawn with
+	if (_glyphSpans == NULL) {
+		s32 glyphCount = _last - _first + 1;
+
+		_glyphSpans = new WoopsiArray<GlyphSpan>();
+		_glyphSpanStart = new s32[glyphCount];
+		_glyphSpanCount = new u16[glyphCount];
+
+		for (s32 i = 0; i < glyphCount; ++i) {
+			_glyphSpanStart[i] = -1;
+			_glyphSpanCount[i] = 0;
+		}
+	}
+
+	u32 index = letter - _first;
+
+	// Decode the glyph the first time it is drawn.  The runs do not depend on
+	// the colour, so they can be reused for every subsequent draw
+	if (_glyphSpanStart[index] < 0) {
+		_glyphSpanStart[index] = _glyphSpans->size();
+		createGlyphSpans(&_glyphData[_glyphOffset[index]], _glyphWidth[index], _glyphSpans);
+		_glyphSpanCount[index] = _glyphSpans->size() - _glyphSpanStart[index];
+	}
+
+	count = _glyphSpanCount[index];
+
+	// Blank glyphs have no runs, and their start index may be the end of the
+	// array or the array may be empty
+	if (count == 0) return NULL;
+
+	return &_glyphSpans->at(_glyphSpanStart[index]);
+}
@@ -16,13 +16,6 @@ Rect::Rect(s16 x, s16 y, s32 width, s32 height) {
 	this->height = height;
 }
 
-Rect::Rect(const Rect& rect) {
-	this->x = rect.getX();
-	this->y = rect.getY();
-	this->width = rect.getWidth();
-	this->height = rect.getHeight();
-}
-
 Rect fromCoordinates(s16 x1, s16 y1, s16 x2, s16 y2) {
 
 	// Ensure x2 is the larger value
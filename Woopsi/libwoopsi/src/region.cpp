@@ -0,0 +1,355 @@
+#include "region.h"
+
+using namespace WoopsiUI;
+
+Region::RectArray Region::_combineOutput;
+
+Region::Region() {
+}
+
+Region::Region(const Rect& rect) {
+	if (rect.hasDimensions()) _rects.push_back(rect);
+}
+
+Region::Region(const Region& region) : _rects(region._rects) {
+}
+
+Region& Region::operator=(const Region& region) {
+	_rects = region._rects;
+
+	return *this;
+}
+
+void Region::getBounds(Rect& rect) const {
+
+	if (isEmpty()) {
+		rect.x = 0;
+		rect.y = 0;
+		rect.width = 0;
+		rect.height = 0;
+		return;
+	}
+
+	// Bands are sorted vertically so the first and last rects give the
+	// vertical extent; the horizontal extent needs a full scan
+	const Rect& first = _rects.at(0);
+	const Rect& last = _rects.at(_rects.size() - 1);
+
+	s32 x1 = first.x;
+	s32 x2 = first.x + first.width;
+
+	for (s32 i = 1; i < _rects.size(); ++i) {
+		const Rect& r = _rects.at(i);
+
+		if (r.x < x1) x1 = r.x;
+		if (r.x + r.width > x2) x2 = r.x + r.width;
+	}
+
+	rect.x = x1;
+	rect.y = first.y;
+	rect.width = x2 - x1;
+	rect.height = (last.y + last.height) - first.y;
+}
+
+bool Region::contains(s16 x, s16 y) const {
+	for (s32 i = 0; i < _rects.size(); ++i) {
+		const Rect& r = _rects.at(i);
+
+		// No further rects can contain the point once we pass it vertically
+		if (r.y > y) return false;
+
+		if (r.contains(x, y)) return true;
+	}
+
+	return false;
+}
+
+bool Region::intersects(const Rect& rect) const {
+
+	if (!rect.hasDimensions()) return false;
+
+	for (s32 i = 0; i < _rects.size(); ++i) {
+		const Rect& r = _rects.at(i);
+
+		// No further rects can intersect once we pass the bottom of the rect
+		if (r.y >= rect.y + rect.height) return false;
+
+		if (r.intersects(rect)) return true;
+	}
+
+	return false;
+}
+
+void Region::addRect(const Rect& rect) {
+
+	if (!rect.hasDimensions()) return;
+
+	if (isEmpty()) {
+		_rects.push_back(rect);
+		return;
+	}
+
+	combine(&rect, 1, OPERATION_UNION);
+}
+
+void Region::addRegion(const Region& region) {
+
+	if (region.isEmpty()) return;
+
+	if (isEmpty()) {
+		*this = region;
+		return;
+	}
+
+	combine(&region._rects.at(0), region.size(), OPERATION_UNION);
+}
+
+void Region::subtractRect(const Rect& rect) {
+
+	if (isEmpty()) return;
+	if (!rect.hasDimensions()) return;
+
+	combine(&rect, 1, OPERATION_SUBTRACT);
+}
+
+void Region::subtractRegion(const Region& region) {
+
+	if (isEmpty()) return;
+	if (region.isEmpty()) return;
+
+	combine(&region._rects.at(0), region.size(), OPERATION_SUBTRACT);
+}
+
+void Region::intersectRect(const Rect& rect) {
+
+	if (isEmpty()) return;
+
+	if (!rect.hasDimensions()) {
+		clear();
+		return;
+	}
+
+	combine(&rect, 1, OPERATION_INTERSECT);
+}
+
+void Region::intersectRegion(const Region& region) {
+
+	if (isEmpty()) return;
+
+	if (region.isEmpty()) {
+		clear();
+		return;
+	}
+
+	combine(&region._rects.at(0), region.size(), OPERATION_INTERSECT);
+}
+
+void Region::translate(s16 x, s16 y) {
+	for (s32 i = 0; i < _rects.size(); ++i) {
+		_rects.at(i).x += x;
+		_rects.at(i).y += y;
+	}
+}
+
+void Region::combine(const Rect* rects, s32 count, Operation operation) {
+
+	const Rect* a = &_rects.at(0);
+	const Rect* b = rects;
+	s32 aCount = _rects.size();
+	s32 bCount = count;
+
+	RectArray& output = _combineOutput;
+	output.clear();
+
+	s32 aIndex = 0;
+	s32 bIndex = 0;
+	s32 aEnd = getBandEnd(a, aCount, aIndex);
+	s32 bEnd = getBandEnd(b, bCount, bIndex);
+	s32 previousBand = -1;
+
+	// Start above anything that an s16 co-ordinate can describe
+	s32 y = -65536;
+
+	// Sweep down both lists, splitting them into horizontal strips in which
+	// neither operand changes, and combine the spans of each strip
+	while ((aIndex < aCount) || (bIndex < bCount)) {
+
+		// Once the first operand is exhausted, only a union can produce more
+		// output; once the second is exhausted, an intersection cannot
+		if ((aIndex >= aCount) && (operation != OPERATION_UNION)) break;
+		if ((bIndex >= bCount) && (operation == OPERATION_INTERSECT)) break;
+
+		s32 aTop = 0x7fffffff;
+		s32 aBottom = 0x7fffffff;
+		s32 bTop = 0x7fffffff;
+		s32 bBottom = 0x7fffffff;
+
+		if (aIndex < aCount) {
+			aTop = a[aIndex].y > y ? a[aIndex].y : y;
+			aBottom = a[aIndex].y + a[aIndex].height;
+		}
+
+		if (bIndex < bCount) {
+			bTop = b[bIndex].y > y ? b[bIndex].y : y;
+			bBottom = b[bIndex].y + b[bIndex].height;
+		}
+
+		s32 top = aTop < bTop ? aTop : bTop;
+		s32 bottom;
+
+		bool useA = (aTop == top);
+		bool useB = (bTop == top);
+
+		if (useA && useB) {
+			bottom = aBottom < bBottom ? aBottom : bBottom;
+		} else if (useA) {
+			bottom = aBottom < bTop ? aBottom : bTop;
+		} else {
+			bottom = bBottom < aTop ? bBottom : aTop;
+		}
+
+		combineBands(useA ? a + aIndex : NULL, useA ? aEnd - aIndex : 0,
+					 useB ? b + bIndex : NULL, useB ? bEnd - bIndex : 0,
+					 top, bottom, operation, &output, previousBand);
+
+		y = bottom;
+
+		// Move past any bands that have been completely consumed
+		if ((aIndex < aCount) && (aBottom <= y)) {
+			aIndex = aEnd;
+			aEnd = getBandEnd(a, aCount, aIndex);
+		}
+
+		if ((bIndex < bCount) && (bBottom <= y)) {
+			bIndex = bEnd;
+			bEnd = getBandEnd(b, bCount, bIndex);
+		}
+	}
+
+	_rects = output;
+}
+
+s32 Region::getBandEnd(const Rect* rects, s32 count, s32 start) {
+
+	if (start >= count) return count;
+
+	s32 end = start + 1;
+
+	while ((end < count) && (rects[end].y == rects[start].y)) ++end;
+
+	return end;
+}
+
+void Region::combineBands(const Rect* a, s32 aCount, const Rect* b, s32 bCount, s32 top, s32 bottom, Operation operation, RectArray* output, s32& previousBand) {
+
+	s32 bandStart = output->size();
+	s32 i = 0;
+	s32 j = 0;
+
+	switch (operation) {
+		case OPERATION_UNION:
+
+			// Merge the two sorted span lists
+			while ((i < aCount) || (j < bCount)) {
+				const Rect* span;
+
+				if ((j >= bCount) || ((i < aCount) && (a[i].x < b[j].x))) {
+					span = &a[i++];
+				} else {
+					span = &b[j++];
+				}
+
+				appendSpan(span->x, span->x + span->width, top, bottom, output, bandStart);
+			}
+			break;
+
+		case OPERATION_INTERSECT:
+			while ((i < aCount) && (j < bCount)) {
+				s32 aX2 = a[i].x + a[i].width;
+				s32 bX2 = b[j].x + b[j].width;
+				s32 x1 = a[i].x > b[j].x ? a[i].x : b[j].x;
+				s32 x2 = aX2 < bX2 ? aX2 : bX2;
+
+				if (x1 < x2) appendSpan(x1, x2, top, bottom, output, bandStart);
+
+				// Advance whichever span finishes first
+				if (aX2 < bX2) {
+					++i;
+				} else {
+					++j;
+				}
+			}
+			break;
+
+		case OPERATION_SUBTRACT:
+			for (i = 0; i < aCount; ++i) {
+				s32 x1 = a[i].x;
+				s32 x2 = a[i].x + a[i].width;
+
+				// Skip subtrahend spans that lie entirely to the left
+				while ((j < bCount) && (b[j].x + b[j].width <= x1)) ++j;
+
+				// Cut each overlapping subtrahend span out of this span
+				for (s32 k = j; (k < bCount) && (b[k].x < x2); ++k) {
+					if (b[k].x > x1) appendSpan(x1, b[k].x, top, bottom, output, bandStart);
+
+					if (b[k].x + b[k].width > x1) x1 = b[k].x + b[k].width;
+
+					if (x1 >= x2) break;
+				}
+
+				if (x1 < x2) appendSpan(x1, x2, top, bottom, output, bandStart);
+			}
+			break;
+	}
+
+	s32 bandSize = output->size() - bandStart;
+
+	if (bandSize == 0) return;
+
+	// Merge with the previous band if it sits directly above and has
+	// exactly the same spans
+	if ((previousBand > -1) && (bandStart - previousBand == bandSize)) {
+		const Rect& previous = output->at(previousBand);
+
+		if (previous.y + previous.height == top) {
+			bool isMatch = true;
+
+			for (s32 k = 0; k < bandSize; ++k) {
+				const Rect& upper = output->at(previousBand + k);
+				const Rect& lower = output->at(bandStart + k);
+
+				if ((upper.x != lower.x) || (upper.width != lower.width)) {
+					isMatch = false;
+					break;
+				}
+			}
+
+			if (isMatch) {
+				for (s32 k = 0; k < bandSize; ++k) {
+					output->at(previousBand + k).height += bottom - top;
+					output->pop_back();
+				}
+
+				return;
+			}
+		}
+	}
+
+	previousBand = bandStart;
+}
+
+void Region::appendSpan(s32 x1, s32 x2, s32 top, s32 bottom, RectArray* output, s32 bandStart) {
+
+	// Extend the previous span in this band if the new span touches it
+	if (output->size() > bandStart) {
+		Rect& last = output->at(output->size() - 1);
+
+		if (last.x + last.width >= x1) {
+			if (x2 > last.x + last.width) last.width = x2 - last.x;
+			return;
+		}
+	}
+
+	output->push_back(Rect(x1, top, x2 - x1, bottom - top));
+}
@@ -145,6 +145,7 @@ void Screen::onDrag(s16 x, s16 y, s16 vX, s16 vY) {
 			}
 			
 			_rect.setY(_newY);
+			invalidateScreenRectCache();
 			
 			// Erase the screen from its old location
 			woopsiApplication->getDamagedRectManager()->addDamagedRect(rect);
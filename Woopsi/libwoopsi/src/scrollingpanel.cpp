@@ -73,7 +73,7 @@ void ScrollingPanel::scroll(s32 dx, s32 dy) {
 		if (_isContentScrolled) {
 
 			// Perform scroll
-			WoopsiArray<Rect> revealedRects(4);
+			WoopsiArray<Rect, 4> revealedRects;
 			GraphicsPort* port = newGraphicsPort(true);
 			port->scroll(0, 0, dx, dy, rect.width, rect.height, &revealedRects);
 			delete port;
@@ -109,20 +109,25 @@ void ScrollingPanel::scroll(s32 dx, s32 dy) {
 }
 
 void ScrollingPanel::scrollChildren(s32 dx, s32 dy) {
-	s16 gadgetX = 0;
-	s16 gadgetY = 0;
-	s16 thisX = getX();
-	s16 thisY = getY();
-	Gadget* gadget = NULL;
 
-	for (s32 i = 0; i < _gadgets.size(); i++) {
+	if (_gadgets.size() == 0) return;
 
-		gadget = _gadgets[i];
+	// Children are positioned relative to the canvas, so changing the canvas
+	// position has moved them all.  Their cached positions and visible
+	// regions are now out of date, as is the area of the panel that they
+	// cover.
+	invalidateScreenRectCache();
+	invalidateVisibleRectCache();
 
-		gadgetX = (gadget->getX() - thisX) + dx;
-		gadgetY = (gadget->getY() - thisY) + dy;
+	// If the content was scrolled the children's pixels have already been
+	// moved along with it; otherwise they must all be redrawn.  Children
+	// that have left the viewport are clipped away by the hierarchy and are
+	// skipped by the redraw.
+	if (!_isContentScrolled) {
+		Rect rect;
+		getClientRect(rect);
 
-		gadget->moveTo(gadgetX, gadgetY);
+		markRectDamaged(rect);
 	}
 }
 
@@ -125,7 +125,7 @@ void ScrollingTextBox::updateScrollbar() {
 	
 	s32 pageSize = div + (2 * mod + _textbox->getDocument()->getLineHeight()) / (2 * _textbox->getDocument()->getLineHeight());
 
-	_scrollbar->setMaximumValue(_textbox->getDocument()->getLineCount());
+	_scrollbar->setMaximumValue(_textbox->getDocument()->getEstimatedLineCount());
 	_scrollbar->setPageSize(pageSize);
 	
 	// Ditto for value
@@ -145,6 +145,14 @@ void ScrollingTextBox::handleScrollEvent(Gadget& source, const WoopsiPoint& delt
 	}
 }
 
+void ScrollingTextBox::handleActionEvent(Gadget& source) {
+
+	// The textbox's canvas has changed height as its text has been wrapped
+	if (&source == _textbox) {
+		updateScrollbar();
+	}
+}
+
 void ScrollingTextBox::drawContents(GraphicsPort* port) {
 	port->drawFilledRect(0, 0, getWidth(), getHeight(), getBackColour());
 }
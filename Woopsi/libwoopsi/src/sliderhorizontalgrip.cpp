@@ -43,7 +43,9 @@ void SliderHorizontalGrip::onReleaseOutside(s16 x, s16 y) {
 void SliderHorizontalGrip::onDrag(s16 x, s16 y, s16 vX, s16 vY) {
 
 	// Work out where we're moving to
-	s16 destX = x - _grabPointX - _parent->getX();
+	s16 destX = x - _grabPointX;
+	s16 destY = y - _grabPointY;
+	convertWoopsiSpaceToParentSpace(&destX, &destY);
 
 	// Do we need to move?
 	if (destX != _rect.getX()) {
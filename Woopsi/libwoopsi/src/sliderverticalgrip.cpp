@@ -43,7 +43,9 @@ void SliderVerticalGrip::onReleaseOutside(s16 x, s16 y) {
 void SliderVerticalGrip::onDrag(s16 x, s16 y, s16 vX, s16 vY) {
 
 	// Work out where we're moving to
-	s16 destY = y - _grabPointY - _parent->getY();
+	s16 destX = x - _grabPointX;
+	s16 destY = y - _grabPointY;
+	convertWoopsiSpaceToParentSpace(&destX, &destY);
 
 	// Do we need to move?
 	if (destY != _rect.getY()) {
@@ -93,6 +93,16 @@ bool StringIterator::moveTo(s32 index) {
 	// Abort if new index matches current index
 	if (index == _currentIndex) return true;
 
+	// Jump directly to the index if the string can locate it without walking
+	// a long way through the string
+	s32 distance = index > _currentIndex ? index - _currentIndex : _currentIndex - index;
+
+	if (_string->isAscii() || (distance > WOOPSI_STRING_INDEX_INTERVAL)) {
+		_currentChar = _string->getToken(index);
+		_currentIndex = index;
+		return true;
+	}
+
 	// Move to end if requested index is at end of string
 	if (index == _string->getLength() - 1) {
 		moveToLast();
@@ -155,7 +165,7 @@ bool StringIterator::moveTo(s32 index) {
 	return false;
 }
 
-u32 StringIterator::getCodePoint() const {
+u32 StringIterator::getMultiByteCodePoint() const {
 	return _string->getCodePoint(_currentChar, NULL);
 }
 
@@ -2,7 +2,10 @@
 #include "bitmap.h"
 #include "bitmapbase.h"
 #include "graphicsport.h"
+#include "woopsi.h"
 #include "woopsifuncs.h"
+#include "woopsitimer.h"
+#include "damagedrectmanager.h"
 
 using namespace WoopsiUI;
 
@@ -26,6 +29,12 @@ SuperBitmap::SuperBitmap(s16 x, s16 y, u16 width, u16 height, u16 bitmapWidth, u
 	}
 
 	clearBitmap();
+
+	// Bitmap changes are flushed to the screen once per VBL
+	_timer = new WoopsiTimer(1, true);
+	addGadget(_timer);
+	_timer->setGadgetEventHandler(this);
+	_timer->start();
 }
 
 SuperBitmap::~SuperBitmap() {
@@ -54,49 +63,85 @@ void SuperBitmap::onClick(s16 x, s16 y) {
 }
 
 void SuperBitmap::onDrag(s16 x, s16 y, s16 vX, s16 vY) {
+	scrollBitmap(_bitmapX - vX, _bitmapY - vY);
+}
+
+void SuperBitmap::setBitmapX(s16 x) {
+	scrollBitmap(x, _bitmapY);
+}
+
+void SuperBitmap::setBitmapY(s16 y) {
+	scrollBitmap(_bitmapX, y);
+}
 
-	_bitmapX -= vX;
-	_bitmapY -= vY;
+void SuperBitmap::scrollBitmap(s32 x, s32 y) {
 
 	// Prevent scrolling outside boundaries of bitmap
-	if (_bitmapX < 0) {
-		_bitmapX = 0;
-	} else if (_bitmapX > _bitmap->getWidth() - getWidth()) {
-		_bitmapX = _bitmap->getWidth() - getWidth();
+	if (x < 0) {
+		x = 0;
+	} else if (x > _bitmap->getWidth() - getWidth()) {
+		x = _bitmap->getWidth() - getWidth();
 	}
 
-	if (_bitmapY < 0) {
-		_bitmapY = 0;
-	} else if (_bitmapY > _bitmap->getHeight() - getHeight()) {
-		_bitmapY = _bitmap->getHeight() - getHeight();
+	if (y < 0) {
+		y = 0;
+	} else if (y > _bitmap->getHeight() - getHeight()) {
+		y = _bitmap->getHeight() - getHeight();
 	}
 
-	markRectsDamaged();
-}
+	s32 dx = _bitmapX - x;
+	s32 dy = _bitmapY - y;
 
-void SuperBitmap::setBitmapX(s16 x) {
-	_bitmapX = x;
+	if ((dx == 0) && (dy == 0)) return;
 
-	// Prevent scrolling outside boundaries of bitmap
-	if (_bitmapX < 0) {
-		_bitmapX = 0;
-	} else if (_bitmapX > _bitmap->getWidth() - getWidth()) {
-		_bitmapX = _bitmap->getWidth() - getWidth();
-	}
+	// Ensure the screen is up-to-date before we start
+	flushDirtyRect();
+	woopsiApplication->getDamagedRectManager()->redraw();
 
-	markRectsDamaged();
-}
+	Rect rect;
+	getClientRect(rect);
 
-void SuperBitmap::setBitmapY(s16 y) {
+	// Move the pixels already on screen
+	WoopsiArray<Rect, 4> revealedRects;
+	GraphicsPort* port = newGraphicsPort(true);
+	port->scroll(0, 0, dx, dy, rect.width, rect.height, &revealedRects);
+	delete port;
+
+	_bitmapX = x;
 	_bitmapY = y;
 
-	if (_bitmapY < 0) {
-		_bitmapY = 0;
-	} else if (_bitmapY > _bitmap->getHeight() - getHeight()) {
-		_bitmapY = _bitmap->getHeight() - getHeight();
+	// Mark the revealed rects as damaged
+	for (s32 i = 0; i < revealedRects.size(); ++i) {
+
+		// Adjust co-ordinates from graphicsport-space to gadget space
+		revealedRects[i].x += rect.x;
+		revealedRects[i].y += rect.y;
+
+		markRectDamaged(revealedRects[i]);
 	}
+}
+
+void SuperBitmap::flushDirtyRect() {
+	if (!_bitmap->isDirty()) return;
+
+	Rect dirty;
+	_bitmap->getDirtyRect(dirty);
+	_bitmap->clearDirtyRect();
+
+	// Convert from bitmap space to gadget space and discard anything that
+	// is not currently shown
+	Rect rect;
+	getClientRect(rect);
+
+	dirty.x += rect.x - _bitmapX;
+	dirty.y += rect.y - _bitmapY;
+	dirty.clipToIntersect(rect);
+
+	if (dirty.hasDimensions()) markRectDamaged(dirty);
+}
 
-	markRectsDamaged();
+void SuperBitmap::handleActionEvent(Gadget& source) {
+	if (&source == _timer) flushDirtyRect();
 }
 
 s16 SuperBitmap::getBitmapX() const {
@@ -28,7 +28,7 @@ void Tab::drawContents(GraphicsPort* port) {
 		textColour = getShineColour();
 	}
 	
-	port->drawText(_textX, _textY, getFont(), _text, 0, _text.getLength(), textColour);
+	port->drawText(_textX, _textY, getFont(), _text, 0, _text.getLength(), textColour, getTextWidth());
 }
 
 void Tab::drawBorder(GraphicsPort* port) {
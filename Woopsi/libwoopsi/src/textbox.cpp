@@ -24,9 +24,10 @@ TextBox::TextBox(s16 x, s16 y, u16 width, u16 height, const WoopsiString& text,
 }
 
 void TextBox::drawContents(GraphicsPort* port) {
+	validateTextPosition();
 
 	u16 textColour = isEnabled() ? getTextColour() : getDarkColour();
-	port->drawText(_textX, _textY, getFont(), _text, 0, _text.getLength(), textColour);
+	port->drawText(_textX, _textY, getFont(), _text, 0, _text.getLength(), textColour, getTextWidth());
 
 	// Draw cursor
 	if (_showCursor && hasFocus()) {
@@ -61,31 +62,24 @@ const u16 TextBox::getCursorXPos() const {
 	// Calculate position of cursor
 	u16 cursorX = 0;
 
-	StringIterator* iterator = _text.newStringIterator();
-	
-	for (u16 i = 0; i < _cursorPos; i++) {
-		cursorX += getFont()->getCharWidth(iterator->getCodePoint());
-			
-		iterator->moveToNext();
-	}
-	
-	delete iterator;
+	if (_cursorPos > 0) cursorX = getFont()->getStringWidth(_text, 0, _cursorPos);
 
 	return cursorX;
 }
 
 void TextBox::setText(const WoopsiString& text) {
 
-	u16 oldWidth = getFont()->getStringWidth(_text);
+	u16 oldWidth = getTextWidth();
 	u16 oldX = _textX;
 	u16 oldY = _textY;
 
 	_text.setText(text);
+	invalidateTextWidth();
 	repositionCursor(_text.getLength());
 
 	calculateTextPositionHorizontal();
 
-	u16 newWidth = getFont()->getStringWidth(_text);
+	u16 newWidth = getTextWidth();
 	u16 newX = _textX;
 	u16 newY = _textY;
 
@@ -109,16 +103,17 @@ void TextBox::setText(const WoopsiString& text) {
 
 void TextBox::appendText(const WoopsiString& text) {
 
-	u16 oldWidth = getFont()->getStringWidth(_text);
+	u16 oldWidth = getTextWidth();
 	u16 oldX = _textX;
 	u16 oldY = _textY;
 
 	_text.append(text);
+	invalidateTextWidth();
 	repositionCursor(_text.getLength());
 
 	calculateTextPositionHorizontal();
 
-	u16 newWidth = getFont()->getStringWidth(_text);
+	u16 newWidth = getTextWidth();
 	u16 newX = _textX;
 	u16 newY = _textY;
 
@@ -142,16 +137,17 @@ void TextBox::appendText(const WoopsiString& text) {
 
 void TextBox::removeText(const u32 startIndex) {
 
-	u16 oldWidth = getFont()->getStringWidth(_text);
+	u16 oldWidth = getTextWidth();
 	u16 oldX = _textX;
 	u16 oldY = _textY;
 
 	_text.remove(startIndex);
+	invalidateTextWidth();
 	repositionCursor(startIndex);
 
 	calculateTextPositionHorizontal();
 
-	u16 newWidth = getFont()->getStringWidth(_text);
+	u16 newWidth = getTextWidth();
 	u16 newX = _textX;
 	u16 newY = _textY;
 
@@ -175,16 +171,17 @@ void TextBox::removeText(const u32 startIndex) {
 
 void TextBox::removeText(const u32 startIndex, const u32 count) {
 
-	u16 oldWidth = getFont()->getStringWidth(_text);
+	u16 oldWidth = getTextWidth();
 	u16 oldX = _textX;
 	u16 oldY = _textY;
 
 	_text.remove(startIndex, count);
+	invalidateTextWidth();
 	repositionCursor(startIndex);
 
 	calculateTextPositionHorizontal();
 
-	u16 newWidth = getFont()->getStringWidth(_text);
+	u16 newWidth = getTextWidth();
 	u16 newX = _textX;
 	u16 newY = _textY;
 
@@ -208,16 +205,17 @@ void TextBox::removeText(const u32 startIndex, const u32 count) {
 
 void TextBox::insertText(const WoopsiString& text, const u32 index) {
 
-	u16 oldWidth = getFont()->getStringWidth(_text);
+	u16 oldWidth = getTextWidth();
 	u16 oldX = _textX;
 	u16 oldY = _textY;
 
 	_text.insert(text, index);
+	invalidateTextWidth();
 	repositionCursor(index + text.getLength());
 
 	calculateTextPositionHorizontal();
 
-	u16 newWidth = getFont()->getStringWidth(_text);
+	u16 newWidth = getTextWidth();
 	u16 newX = _textX;
 	u16 newY = _textY;
 
@@ -295,20 +293,20 @@ void TextBox::moveCursorToClickLocation(s16 x, s16 y) {
 		s16 charX = _textX;
 
 		// Locate the first character that comes after the clicked character
-		StringIterator* iterator = _text.newStringIterator();
+		StringIterator iterator(&_text);
 
 		while (charX < clickX) {
-			charX += getFont()->getCharWidth(iterator->getCodePoint());
+			charX += getFont()->getCharWidth(iterator.getCodePoint());
 			
-			if (!iterator->moveToNext()) break;
+			if (!iterator.moveToNext()) break;
 		}
 		
-		u32 index = iterator->getIndex();
+		u32 index = iterator.getIndex();
 
 		// Move back to the clicked character if we've moved past it
 		if (charX > clickX) {
-			iterator->moveToPrevious();
-			index = iterator->getIndex();
+			iterator.moveToPrevious();
+			index = iterator.getIndex();
 		} else if (charX < clickX) { 
 			
 			// Move past end of string if click is after the text
@@ -316,8 +314,6 @@ void TextBox::moveCursorToClickLocation(s16 x, s16 y) {
 		}
 
 		moveCursorToPosition(index);
-
-		delete iterator;
 	}
 }
 
@@ -365,7 +361,7 @@ void TextBox::calculateTextPositionHorizontal() {
 	
 	// Calculate the string width - if the width is longer than the box,
 	// ignore alignment and align left
-	u16 stringWidth = getFont()->getStringWidth(_text);
+	u16 stringWidth = getTextWidth();
 	
 	// Add the width of a blank space to the width to ensure that we can
 	// see the cursor
@@ -0,0 +1,148 @@
+#include "timerwheel.h"
+
+using namespace WoopsiUI;
+
+TimerHandle::~TimerHandle() {
+	cancel();
+}
+
+void TimerHandle::cancel() {
+	if (_wheel != NULL) _wheel->cancel(this);
+}
+
+TimerWheel::TimerWheel() {
+	_time = 0;
+
+	for (s32 level = 0; level < TIMER_WHEEL_LEVELS; ++level) {
+		for (s32 slot = 0; slot < TIMER_WHEEL_SLOTS; ++slot) {
+			_slots[level][slot] = NULL;
+		}
+	}
+}
+
+TimerWheel::~TimerWheel() {
+
+	// Disarm everything so that handles destroyed later do not try to
+	// remove themselves from a wheel that no longer exists
+	for (s32 level = 0; level < TIMER_WHEEL_LEVELS; ++level) {
+		for (s32 slot = 0; slot < TIMER_WHEEL_SLOTS; ++slot) {
+			while (_slots[level][slot] != NULL) {
+				cancel(_slots[level][slot]);
+			}
+		}
+	}
+}
+
+void TimerWheel::arm(TimerHandle* handle, u32 delay) {
+	if (handle->_wheel != NULL) handle->_wheel->cancel(handle);
+
+	if (delay == 0) delay = 1;
+
+	handle->_wheel = this;
+	handle->_expiryTime = _time + delay;
+
+	insert(handle);
+}
+
+void TimerWheel::cancel(TimerHandle* handle) {
+	if (handle->_wheel != this) return;
+
+	unlink(handle);
+	handle->_wheel = NULL;
+}
+
+void TimerWheel::tick() {
+	++_time;
+
+	// Whenever a level wraps around, pull the next slot of the level above
+	// down into the lower levels.  Timers that expire now end up in the
+	// current level 0 slot.
+	for (s32 level = 1; level < TIMER_WHEEL_LEVELS; ++level) {
+		if ((_time & ((1 << (TIMER_WHEEL_BITS * level)) - 1)) != 0) break;
+
+		cascade(level, (_time >> (TIMER_WHEEL_BITS * level)) & (TIMER_WHEEL_SLOTS - 1));
+	}
+
+	// Fire everything in the current slot.  Handles are removed one at a
+	// time so that handlers can safely cancel or re-arm any timer,
+	// including others in this slot.  Re-armed timers always go into a
+	// different slot.
+	TimerHandle** slot = &_slots[0][_time & (TIMER_WHEEL_SLOTS - 1)];
+
+	while (*slot != NULL) {
+		TimerHandle* handle = *slot;
+
+		unlink(handle);
+		handle->_wheel = NULL;
+		handle->onTimerExpired();
+	}
+}
+
+void TimerWheel::insert(TimerHandle* handle) {
+	u32 delta = handle->_expiryTime - _time;
+	u32 expiryTime = handle->_expiryTime;
+
+	// Find the lowest level whose range covers the delay
+	s32 level = 0;
+
+	while ((level < TIMER_WHEEL_LEVELS - 1) && (delta >= (u32)1 << (TIMER_WHEEL_BITS * (level + 1)))) {
+		++level;
+	}
+
+	// Timers beyond the range of the wheel are parked in the furthest slot
+	// and reinserted when it cascades
+	if ((level == TIMER_WHEEL_LEVELS - 1) && (delta >= (u32)1 << (TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS))) {
+		expiryTime = _time + ((u32)1 << (TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS)) - 1;
+	}
+
+	s32 slot = (expiryTime >> (TIMER_WHEEL_BITS * level)) & (TIMER_WHEEL_SLOTS - 1);
+
+	append(&_slots[level][slot], handle);
+}
+
+void TimerWheel::append(TimerHandle** list, TimerHandle* handle) {
+	handle->_list = list;
+
+	if (*list == NULL) {
+		handle->_next = handle;
+		handle->_prev = handle;
+		*list = handle;
+		return;
+	}
+
+	// Lists are circular, so the head's previous handle is the tail
+	TimerHandle* tail = (*list)->_prev;
+
+	tail->_next = handle;
+	handle->_prev = tail;
+	handle->_next = *list;
+	(*list)->_prev = handle;
+}
+
+void TimerWheel::unlink(TimerHandle* handle) {
+	TimerHandle** list = handle->_list;
+
+	if (handle->_next == handle) {
+		*list = NULL;
+	} else {
+		handle->_prev->_next = handle->_next;
+		handle->_next->_prev = handle->_prev;
+
+		if (*list == handle) *list = handle->_next;
+	}
+
+	handle->_next = NULL;
+	handle->_prev = NULL;
+	handle->_list = NULL;
+}
+
+void TimerWheel::cascade(s32 level, s32 slot) {
+	TimerHandle** list = &_slots[level][slot];
+
+	while (*list != NULL) {
+		TimerHandle* handle = *list;
+
+		unlink(handle);
+		insert(handle);
+	}
+}
@@ -6,25 +6,18 @@ using namespace WoopsiUI;
 
 Window::Window(s16 x, s16 y, u16 width, u16 height, const WoopsiString& title, GadgetStyle* style) : Gadget(x, y, width, height, style) {
 	_title = title;
+	_isOpaqueDrag = false;
 }
 
 void Window::onDragStop() {
+
+	// Window has been moving with the stylus
+	if (_isOpaqueDrag) return;
 	
 	woopsiApplication->getDamagedRectManager()->redraw();
 	
-	// Get a graphics port from the parent screen
-	GraphicsPort* port = _parent->newGraphicsPort(true);
-	
-	// Since we're drawing to the parent gadget's graphics port,
-	// we need to ensure that we subtract the parent's client rect
-	// offset from our drawing co-ordinates
-	Rect rect;
-	_parent->getClientRect(rect);
-	
-	// Draw rect
-	port->drawXORRect(_newX - rect.x, _newY - rect.y, getWidth(), getHeight());
-	
-	delete port;
+	// Erase the outline
+	drawDragOutline();
 	
 	moveTo(_newX, _newY);
 }
@@ -32,18 +25,28 @@ void Window::onDragStop() {
 void Window::onDrag(s16 x, s16 y, s16 vX, s16 vY) {
 
 	// Work out where we're moving to
-	s16 destX = x - _grabPointX - _parent->getX();
-	s16 destY = y - _grabPointY - _parent->getY();
+	s16 destX = x - _grabPointX;
+	s16 destY = y - _grabPointY;
+	convertWoopsiSpaceToParentSpace(&destX, &destY);
 
 	// Do we need to move?
 	if ((destX != _rect.getX()) || (destY != _rect.getY())) {
 
+		// Find the parent's top-left corner in the same space as the
+		// destination, which differs if the parent scrolls its children
+		s16 parentX = _parent->getX();
+		s16 parentY = _parent->getY();
+		convertWoopsiSpaceToParentSpace(&parentX, &parentY);
+
 		// Prevent window from moving outside screen
 		if (!_parent->isPermeable()) {
 
 			Rect rect;
 			_parent->getClientRect(rect);
 
+			rect.x += parentX;
+			rect.y += parentY;
+
 			if (destX < rect.x) {
 				destX = rect.x;
 			} else if (destX + getWidth() > rect.x + rect.width) {
@@ -58,32 +61,31 @@ void Window::onDrag(s16 x, s16 y, s16 vX, s16 vY) {
 		}
 
 		// Prevent window from leaving top of screen
-		if (destY < 0) {
-			destY = 0;
+		if (destY < parentY) {
+			destY = parentY;
 		}
 		
 		woopsiApplication->getDamagedRectManager()->redraw();
 
-		// Get a graphics port from the parent screen
-		GraphicsPort* port = _parent->newGraphicsPort(true);
+		if (_isOpaqueDrag) {
 
-		// Since we're drawing to the parent gadget's graphics port,
-		// we need to ensure that we subtract the parent's client rect
-		// offset from our drawing co-ordinates
-		Rect rect;
-		_parent->getClientRect(rect);
+			// Copy the window to its new position; only the areas it
+			// uncovers are redrawn
+			_newX = destX;
+			_newY = destY;
+			moveTo(destX, destY);
+			return;
+		}
 
 		// Erase the old rect
-		port->drawXORRect(_newX - rect.x, _newY - rect.y, getWidth(), getHeight());
+		drawDragOutline();
 
 		// Perform move
 		_newX = destX;
 		_newY = destY;
 
 		// Draw the new rect
-		port->drawXORRect(_newX - rect.x, _newY - rect.y, getWidth(), getHeight());
-
-		delete port;
+		drawDragOutline();
 	}
 }
 
@@ -98,22 +100,30 @@ void Window::setTitle(const WoopsiString& title) {
 }
 
 void Window::onDragStart() {
+
+	// No outline needed if the window itself is dragged
+	if (_isOpaqueDrag) return;
 	
 	woopsiApplication->getDamagedRectManager()->redraw();
 
 	// Draw XOR rect
+	drawDragOutline();
+}
+
+void Window::drawDragOutline() {
 
 	// Get a graphics port from the parent screen
 	GraphicsPort* port = _parent->newGraphicsPort(true);
 
 	// Since we're drawing to the parent gadget's graphics port,
-	// we need to ensure that we subtract the parent's client rect
-	// offset from our drawing co-ordinates
-	Rect rect;
-	_parent->getClientRect(rect);
+	// we need to convert the outline to Woopsi-space and then
+	// subtract the port's position from it
+	s16 x = _newX;
+	s16 y = _newY;
+	convertParentSpaceToWoopsiSpace(&x, &y);
 
 	// Draw rect
-	port->drawXORRect(_newX - rect.x, _newY - rect.y, getWidth(), getHeight());
+	port->drawXORRect(x - port->getX(), y - port->getY(), getWidth(), getHeight());
 
 	delete port;
 }
@@ -8,6 +8,7 @@
 #include "pad.h"
 #include "screen.h"
 #include "stylus.h"
+#include "timerwheel.h"
 #include "woopsi.h"
 #include "woopsifuncs.h"
 #include "woopsikeyboard.h"
@@ -33,6 +34,7 @@ Woopsi::Woopsi(GadgetStyle* style) : Gadget(0, 0, SCREEN_WIDTH, TOP_SCREEN_Y_OFF
 	singleton = this;
 
 	_damagedRectManager = new DamagedRectManager(this);
+	_timerWheel = new TimerWheel();
 
 	woopsiInitDefaultGadgetStyle();
 
@@ -99,6 +101,9 @@ Woopsi::~Woopsi() {
 	delete _damagedRectManager;
 	_damagedRectManager = NULL;
 
+	delete _timerWheel;
+	_timerWheel = NULL;
+
 	Hardware::shutdown();
 
 	woopsiFreeDefaultGadgetStyle();
@@ -124,12 +129,8 @@ void Woopsi::handleVBL() {
 	// Delete any queued gadgets
 	processDeleteQueue();
 
-	// VBL
-	s32 i = 0;
-	while (i < _vblListeners.size()) {
-		_vblListeners[i]->run();
-		i++;
-	}
+	// Fire any timers that expire on this VBL
+	_timerWheel->tick();
 }
 
 // Process all stylus input
@@ -147,13 +148,39 @@ void Woopsi::handleStylus(Gadget* gadget) {
 		}
 	} else if (stylus.isHeld()) {
 		if (_clickedGadget != NULL) {
-			_clickedGadget->drag(stylus.getX(), stylus.getY(), stylus.getVX(), stylus.getVY());
+			if (_clickedGadget->receivesDragPath()) {
+				handleDragPath();
+			} else {
+				_clickedGadget->drag(stylus.getX(), stylus.getY(), stylus.getVX(), stylus.getVY());
+			}
 		}
 	} else if (_clickedGadget != NULL) {
 		_clickedGadget->release(stylus.getX(), stylus.getY());
 	}
 }
 
+void Woopsi::handleDragPath() {
+
+	const Stylus& stylus = Hardware::getStylus();
+
+	// Start from the position at the previous VBL
+	s16 x = stylus.getX() - stylus.getVX();
+	s16 y = stylus.getY() - stylus.getVY();
+
+	// Drag through each recorded position in turn.  The gadget may be
+	// released by a drag handler, so check it every time.
+	for (s32 i = 0; i < stylus.getSampleCount(); ++i) {
+		if (_clickedGadget == NULL) return;
+
+		const Stylus::Sample& sample = stylus.getSample(i);
+
+		_clickedGadget->drag(sample.x, sample.y, sample.x - x, sample.y - y);
+
+		x = sample.x;
+		y = sample.y;
+	}
+}
+
 void Woopsi::handleShiftClick(s16 x, s16 y, Gadget* gadget) {
 
 	// Shelve the existing context menu to ensure that if
@@ -329,32 +356,6 @@ bool Woopsi::flipScreens(Gadget* gadget) {
 	return true;
 }
 
-// Add a timer to the list of timers that receive VBL events
-void Woopsi::registerForVBL(WoopsiTimer* timer) {
-
-	// Ensure gadget is not already in the list
-	for (s32 i = 0; i < _vblListeners.size(); i++) {
-		if (_vblListeners[i] == timer) {
-			return;
-		}
-	}
-
-	_vblListeners.push_back(timer);
-}
-
-// Remove a timer from the VBL list
-void Woopsi::unregisterFromVBL(WoopsiTimer* timer) {
-	
-	// Locate gadget in the list
-	for (s32 i = 0; i < _vblListeners.size(); i++) {
-		if (_vblListeners[i] == timer) {
-			_vblListeners.erase(i);
-			return;
-		}
-	}
-}
-
-
 // Delete all gadgets in the queue
 void Woopsi::processDeleteQueue() {
 
@@ -26,6 +26,15 @@ WoopsiString::WoopsiString(const WoopsiString& string) {
 	setText(string);
 }
 
+#if __cplusplus >= 201103L
+
+WoopsiString::WoopsiString(WoopsiString&& string) {
+	init();
+	swap(string);
+}
+
+#endif
+
 WoopsiString::WoopsiString(const WoopsiString& string, const s32 startIndex) {
 	init();
 	setText(string, startIndex, string.getLength());
@@ -37,11 +46,11 @@ WoopsiString::WoopsiString(const WoopsiString& string, const s32 startIndex, con
 }
 
 void WoopsiString::init() {
-	_text = NULL;
+	_text = _inlineText;
 	_dataLength = 0;
 	_stringLength = 0;
-	_allocatedSize = 0;
-	_growAmount = 32;
+	_allocatedSize = WOOPSI_STRING_INLINE_SIZE;
+	_tokenIndex = NULL;
 }
 
 WoopsiString& WoopsiString::operator=(const WoopsiString& string) {
@@ -52,6 +61,18 @@ WoopsiString& WoopsiString::operator=(const WoopsiString& string) {
 	return *this;
 }
 
+#if __cplusplus >= 201103L
+
+WoopsiString& WoopsiString::operator=(WoopsiString&& string) {
+	if (&string != this) {
+		swap(string);
+	}
+
+	return *this;
+}
+
+#endif
+
 WoopsiString& WoopsiString::operator=(const char* string) {
 	setText(string);
 	return *this;
@@ -81,22 +102,40 @@ StringIterator* WoopsiString::newStringIterator() const {
 
 void WoopsiString::setText(const WoopsiString& text, const s32 startIndex, const s32 length) {
 
-	StringIterator* iterator = text.newStringIterator();
-	if (!iterator->moveTo(startIndex)) return;
-
-	// Build up the string character by character.  This is slower than
-	// a straightforward memcpy(), but it avoids multiple calls to getToken().
-	// The difference in speed between this method and a more long-winded, lower
-	// level approach is probably minimal.  This method gets bounds checking for
-	// free.
-	s32 count = 0;
-	while (count < length) {
-		append(iterator->getCodePoint());
-		if (!iterator->moveToNext()) break;
-		count++;
+	// Invalid ranges produce an empty string
+	if ((startIndex < 0) || (startIndex >= text.getLength()) || (length <= 0)) {
+		_dataLength = 0;
+		_stringLength = 0;
+
+		truncateTokenIndex(0);
+		return;
+	}
+
+	// Clip the substring to the end of the text
+	s32 count = text.getLength() - startIndex;
+
+	if (length < count) count = length;
+
+	s32 endIndex = startIndex + count;
+
+	// Locate the bytes that make up the substring
+	const char* start = text.getToken(startIndex);
+	const char* end = endIndex < text.getLength() ? text.getToken(endIndex) : text.getCharArray() + text.getByteCount();
+
+	s32 bytes = (s32)(end - start);
+
+	// Substrings of this string can be moved within the existing memory
+	if (&text == this) {
+		memmove(_text, start, bytes);
+	} else {
+		allocateMemory(bytes, false);
+		memcpy(_text, start, bytes);
 	}
 
-	delete iterator;
+	_dataLength = bytes;
+	_stringLength = count;
+
+	truncateTokenIndex(0);
 }
 
 void WoopsiString::setText(const WoopsiString& text) {
@@ -104,12 +143,12 @@ void WoopsiString::setText(const WoopsiString& text) {
 	// Ensure we've got enough memory available
 	allocateMemory(text.getByteCount(), false);
 
-	if (_text) {
-		memcpy(_text, text.getCharArray(), text.getByteCount());
-	}
+	memcpy(_text, text.getCharArray(), text.getByteCount());
 
 	_dataLength = text.getByteCount();
 	_stringLength = text.getLength();
+
+	truncateTokenIndex(0);
 }
 
 void WoopsiString::setText(const char* text) {
@@ -123,16 +162,18 @@ void WoopsiString::setText(const char* text) {
 	s32 unicodeChars = 0;
 	_dataLength = filterString(_text, text, length, &unicodeChars);
 	_stringLength = unicodeChars;
+
+	truncateTokenIndex(0);
 }
 
 void WoopsiString::setText(const u32 codePoint) {
 
 	// Encode the character
-	u8 numBytes = 0;
-	const char* encoded = encodeCodePoint(codePoint, &numBytes);
+	char encoded[4];
+	u8 numBytes = encodeCodePoint(codePoint, encoded);
 
 	// Is the codepoint valid?
-	if (encoded != NULL) {
+	if (numBytes > 0) {
 
 		// Ensure we've got enough memory available
 		allocateMemory(numBytes, false);
@@ -142,14 +183,14 @@ void WoopsiString::setText(const u32 codePoint) {
 		
 		_dataLength = numBytes;
 		_stringLength = 1;
-	
-		delete[] encoded;
 	} else {
 		
 		// Codepoint is invalid; we just need to truncate the string
 		_dataLength = 0;
 		_stringLength = 0;
 	}
+
+	truncateTokenIndex(0);
 }
 
 void WoopsiString::append(const WoopsiString& text) {
@@ -157,9 +198,7 @@ void WoopsiString::append(const WoopsiString& text) {
 	// Ensure we've got enough memory available
 	allocateMemory(_dataLength + text.getByteCount(), true);
 
-	if (_text) {
-		memcpy(_text + _dataLength, text.getCharArray(), text.getByteCount());
-	}
+	memcpy(_text + _dataLength, text.getCharArray(), text.getByteCount());
 
 	_dataLength += text.getByteCount();
 	_stringLength += text.getLength();
@@ -170,28 +209,59 @@ char* WoopsiString::getToken(s32 index) const {
 	// Early exit if the string is empty
 	if (!hasData()) return NULL;
 
-	// Early exit if we want the entire string
-	if (index == 0) return _text;
+	// Early exit if the index is outside the string
+	if ((index < 0) || (index >= _stringLength)) return NULL;
 
-	// Early exit if the index is greater than the length of the string
-	if (index >= _stringLength) return NULL;
+	// ASCII strings have one byte per token
+	if (isAscii()) return _text + index;
 
-	char token;
-	char* pos = _text;
+	if (_tokenIndex == NULL) _tokenIndex = new WoopsiArray<s32>();
 
-	while (index > 0) {
+	// The first entry is always the start of the string
+	if (_tokenIndex->size() == 0) _tokenIndex->push_back(0);
+
+	s32 entry = index / WOOPSI_STRING_INDEX_INTERVAL;
+	char* pos;
 
-		pos++;
-		token = *pos;
+	// Extend the index until it covers the requested token
+	while (_tokenIndex->size() <= entry) {
+		pos = _text + _tokenIndex->at(_tokenIndex->size() - 1);
 
-		if ((token < 0x80) || ((token > 0xC2) && (token < 0xFE))) {
-			if (index <= 1) return pos;
-			index--;
+		for (s32 i = 0; i < WOOPSI_STRING_INDEX_INTERVAL; ++i) {
+
+			// Skip the lead byte and any continuation bytes that follow it
+			do {
+				pos++;
+			} while (((unsigned char)*pos >= 0x80) && ((unsigned char)*pos < 0xC0));
 		}
+
+		_tokenIndex->push_back((s32)(pos - _text));
+	}
+
+	// Walk from the nearest indexed token to the requested token
+	pos = _text + _tokenIndex->at(entry);
+	index -= entry * WOOPSI_STRING_INDEX_INTERVAL;
+
+	while (index > 0) {
+		do {
+			pos++;
+		} while (((unsigned char)*pos >= 0x80) && ((unsigned char)*pos < 0xC0));
+
+		index--;
 	}
 
-	// No corresponding token found
-	return NULL;
+	return pos;
+}
+
+void WoopsiString::truncateTokenIndex(const s32 index) {
+	if (_tokenIndex == NULL) return;
+
+	// Entries at or before the change point describe text that has not moved
+	s32 validEntries = (index / WOOPSI_STRING_INDEX_INTERVAL) + 1;
+
+	while (_tokenIndex->size() > validEntries) {
+		_tokenIndex->pop_back();
+	}
 }
 
 void WoopsiString::insert(const WoopsiString& text, s32 index) { 
@@ -208,53 +278,29 @@ void WoopsiString::insert(const WoopsiString& text, s32 index) {
 		return;
 	}
 
+	// Inserting a string into itself would overwrite the text being inserted
+	if (&text == this) {
+		WoopsiString copy(text);
+		WoopsiString::insert(copy, index);
+		return;
+	}
+
 	// Locate the point at which we can cut the existing string 
 	s32 insertPoint = (s32)(getToken(index) - _text);
 
-	// Get the total size of the string that we need
-	s32 newSize = _dataLength + text.getByteCount();
-
-	// Reallocate memory if the existing memory isn't large enough
-	if (_allocatedSize < newSize) {
-		
-		newSize += _growAmount;
-
-		// Allocate new string large enough to contain additional data
-		char* newText = new char[newSize];
-
-		// Copy the start of the existing text to the newly allocated string
-		if (insertPoint > 0) memcpy(newText, _text, insertPoint);
-
-		// Insert the additional text into the new string
-		u32 size = text.getByteCount();
-		
-		memcpy(newText + insertPoint, text.getCharArray(), size);
-		_stringLength += text.getLength();
-
-		// Copy the end of the existing text the the newly allocated string
-		if (_dataLength > insertPoint) memcpy(newText + insertPoint + size, _text + insertPoint, _dataLength - insertPoint);
-
-		_allocatedSize = newSize;
-
-		// Delete existing string
-		delete[] _text;
+	truncateTokenIndex(index);
 
-		// Swap pointers 
-		_text = newText;				
-		_dataLength += size;
-	} else {
+	s32 size = text.getByteCount();
 
-		// Existing size large enough, so make space in string for insert
-		for (s32 i = 0; i < _dataLength - insertPoint; ++i) {
-			_text[newSize - i - 1] = _text[_dataLength - i - 1];
-		}
+	// Ensure we've got enough memory available
+	allocateMemory(_dataLength + size, true);
 
-		// Insert the additional text into the new string
-		memcpy(_text + insertPoint, text.getCharArray(), text.getByteCount());
+	// Make space in the string for the insert and copy the new text into it
+	memmove(_text + insertPoint + size, _text + insertPoint, _dataLength - insertPoint);
+	memcpy(_text + insertPoint, text.getCharArray(), size);
 
-		_dataLength += text.getByteCount();
-		_stringLength += text.getLength();
-	}
+	_dataLength += size;
+	_stringLength += text.getLength();
 }
 
 void WoopsiString::remove(const s32 startIndex) {
@@ -274,6 +320,8 @@ void WoopsiString::remove(const s32 startIndex) {
 	// decrease the length
 	_dataLength = (s32)(pos - _text);
 
+	truncateTokenIndex(startIndex);
+
 	_stringLength -= (_stringLength - startIndex);
 }
 
@@ -303,6 +351,8 @@ void WoopsiString::remove(const s32 startIndex, const s32 count) {
 	// Abort if unable to find end point
 	if (endPos == NULL) while(1) { };//return;
 
+	truncateTokenIndex(startIndex);
+
 	// Copy characters from a point after the area to be deleted into the space created
 	// by the deletion
 	if (startPos < endPos) memmove(startPos, endPos, _dataLength - u32(endPos - _text));
@@ -337,19 +387,17 @@ const s32 WoopsiString::indexOf(u32 letter, s32 startIndex, s32 count) const {
 	s32 index = -1;
 	s32 charsExamined = 0;
 
-	StringIterator* iterator = newStringIterator();
-	if (!iterator->moveTo(startIndex)) return -1;
+	StringIterator iterator(this);
+	if (!iterator.moveTo(startIndex)) return -1;
 
 	do {
-		if (iterator->getCodePoint() == letter) {
-			index = iterator->getIndex();
+		if (iterator.getCodePoint() == letter) {
+			index = iterator.getIndex();
 			break;
 		}
 
 		charsExamined++;
-	} while (iterator->moveToNext() && (charsExamined < count));
-
-	delete iterator;
+	} while (iterator.moveToNext() && (charsExamined < count));
 
 	return index;
 }
@@ -370,19 +418,17 @@ const s32 WoopsiString::lastIndexOf(u32 letter, s32 startIndex, s32 count) const
 	s32 index = -1;
 	s32 charsExamined = 0;
 
-	StringIterator* iterator = newStringIterator();
-	if (!iterator->moveTo(startIndex)) return -1;
+	StringIterator iterator(this);
+	if (!iterator.moveTo(startIndex)) return -1;
 
 	do {
-		if (iterator->getCodePoint() == letter) {
-			index = iterator->getIndex();
+		if (iterator.getCodePoint() == letter) {
+			index = iterator.getIndex();
 			break;
 		}
 
 		charsExamined++;
-	} while (iterator->moveToPrevious() && (charsExamined <= count));
-
-	delete iterator;
+	} while (iterator.moveToPrevious() && (charsExamined <= count));
 
 	return index;
 }
@@ -403,26 +449,67 @@ void WoopsiString::allocateMemory(s32 chars, bool preserve) {
 	
 	if (chars > _allocatedSize) {
 
-		// Not enough space in existing memory; allocate new memory
-		char* newText = new char[chars + _growAmount];
+		// Grow geometrically so that a string built by repeated appends only
+		// needs to reallocate a logarithmic number of times
+		s32 newSize = _allocatedSize << 1;
 
-		// Free old memory if necessary
-		if (_text != NULL) {
+		if (newSize < chars) newSize = chars;
+
+		// Not enough space in existing memory; allocate new memory
+		char* newText = new char[newSize];
 
-			// Preserve existing data if required
-			if (preserve) memcpy(newText, _text, _dataLength);
+		// Preserve existing data if required
+		if (preserve) memcpy(newText, _text, _dataLength);
 
-			delete[] _text;
-		}
+		// Free old memory if necessary
+		if (_text != _inlineText) delete[] _text;
 
 		// Swap pointer to new memory
 		_text = newText;
 
 		// Remember how much memory we've allocated
-		_allocatedSize = chars + _growAmount;
+		_allocatedSize = newSize;
 	}
 }
 
+void WoopsiString::reserve(const s32 bytes) {
+	allocateMemory(bytes, true);
+}
+
+void WoopsiString::swap(WoopsiString& string) {
+
+	bool isInline = (_text == _inlineText);
+	bool isOtherInline = (string._text == string._inlineText);
+
+	// Exchange the inline buffers; strings stored in them move with the
+	// buffers, whilst heap strings just exchange pointers
+	char inlineText[WOOPSI_STRING_INLINE_SIZE];
+
+	memcpy(inlineText, _inlineText, WOOPSI_STRING_INLINE_SIZE);
+	memcpy(_inlineText, string._inlineText, WOOPSI_STRING_INLINE_SIZE);
+	memcpy(string._inlineText, inlineText, WOOPSI_STRING_INLINE_SIZE);
+
+	char* text = _text;
+	_text = isOtherInline ? _inlineText : string._text;
+	string._text = isInline ? string._inlineText : text;
+
+	s32 dataLength = _dataLength;
+	_dataLength = string._dataLength;
+	string._dataLength = dataLength;
+
+	s32 stringLength = _stringLength;
+	_stringLength = string._stringLength;
+	string._stringLength = stringLength;
+
+	s32 allocatedSize = _allocatedSize;
+	_allocatedSize = string._allocatedSize;
+	string._allocatedSize = allocatedSize;
+
+	WoopsiArray<s32>* tokenIndex = _tokenIndex;
+	_tokenIndex = string._tokenIndex;
+	string._tokenIndex = tokenIndex;
+}
+
 void WoopsiString::copyToCharArray(char* buffer) const {
 	memcpy(buffer, _text, _dataLength);
 	buffer[_dataLength] = '\0';
@@ -521,52 +608,42 @@ u32 WoopsiString::getCodePoint(const char* string, u8* numChars) const {
 	return 0;
 }
 
-const char* WoopsiString::encodeCodePoint(u32 codepoint, u8* numBytes) const {
-	
-	if (numBytes) *numBytes = 0;
+u8 WoopsiString::encodeCodePoint(u32 codepoint, char* buffer) const {
 	
 	if (codepoint < 0x80) {
-		if (numBytes) *numBytes = 1;
-		char* buffer = new char[1];
 		buffer[0] = codepoint;
-		return buffer;
+		return 1;
 	}
 
 	if (codepoint < 0x0800) {
-		if (numBytes) *numBytes = 2;
-		char* buffer = new char[2];
 		buffer[0] = (codepoint >> 6) + 0xC0;
 		buffer[1] = (codepoint & 0x1F) + 0x80;
-		return buffer;
+		return 2;
 	}
 
 	if (codepoint < 0x10000) {
-		if (numBytes) *numBytes = 3;
-		char* buffer = new char[3];
 		buffer[0] = (codepoint >> 12) + 0xE0;
 		buffer[1] = ((codepoint >> 6) & 0x3F) + 0x80;
 		buffer[2] = (codepoint & 0x3F) + 0x80;
-		return buffer;
+		return 3;
 	}
 	
 	if (codepoint < 0x10FFFF) {
-		if (numBytes) *numBytes = 4;
-		char* buffer = new char[4];
 		buffer[0] = (codepoint >> 18) + 0xF0;
 		buffer[1] = ((codepoint >> 12) & 0x3F) + 0x80;
 		buffer[2] = ((codepoint >> 6) & 0x3F) + 0x80;
 		buffer[3] = (codepoint & 0x3F) + 0x80;
-		return buffer;
+		return 4;
 	}
 
 	// No legal codepoints after this point
-	return NULL;
+	return 0;
 }
 
 s8 WoopsiString::compareTo(const WoopsiString& string, bool caseSensitive) const {
 	
-	StringIterator* iterator1 = newStringIterator();
-	StringIterator* iterator2 = string.newStringIterator();
+	StringIterator iterator1(this);
+	StringIterator iterator2(&string);
 	
 	u32 codePoint1;
 	u32 codePoint2;
@@ -577,8 +654,8 @@ s8 WoopsiString::compareTo(const WoopsiString& string, bool caseSensitive) const
 	// Iterate over the string length that both strings possess and check for
 	// differences.
 	for (u32 i = 0; i < length; ++i) {
-		codePoint1 = iterator1->getCodePoint();
-		codePoint2 = iterator2->getCodePoint();
+		codePoint1 = iterator1.getCodePoint();
+		codePoint2 = iterator2.getCodePoint();
 		
 		// If we are ignoring case, we can adjust any upper-case letters so that
 		// they are treated as their lower-case variant by adding a constant.
@@ -597,25 +674,19 @@ s8 WoopsiString::compareTo(const WoopsiString& string, bool caseSensitive) const
 			u32 charCount1 = 0;
 			u32 charCount2 = 0;
 
-			codePoint1 = iterator1->getInteger(&charCount1);
-			codePoint2 = iterator2->getInteger(&charCount2);
+			codePoint1 = iterator1.getInteger(&charCount1);
+			codePoint2 = iterator2.getInteger(&charCount2);
 
 			if (codePoint1 != codePoint2) {
-				delete iterator1;
-				delete iterator2;
-				
 				return codePoint1 > codePoint2 ? 1 : -1;
 			}
 
 			// Stop iterating if we hit the end of either string
-			if (!iterator1->moveTo(iterator1->getIndex() + charCount1) ||
-				!iterator2->moveTo(iterator2->getIndex() + charCount2)) break;
+			if (!iterator1.moveTo(iterator1.getIndex() + charCount1) ||
+				!iterator2.moveTo(iterator2.getIndex() + charCount2)) break;
 		} else {
 	    
 			if (codePoint1 != codePoint2) {
-				delete iterator1;
-				delete iterator2;
-				
 				return codePoint1 > codePoint2 ? 1 : -1;
 			}
 			
@@ -624,13 +695,10 @@ s8 WoopsiString::compareTo(const WoopsiString& string, bool caseSensitive) const
 			// and compared
 			// multiple characters in a single iteration.  In that situation we
 			// need to exit the loop early.
-			if (!iterator1->moveToNext() || !iterator2->moveToNext()) break;
+			if (!iterator1.moveToNext() || !iterator2.moveToNext()) break;
 		}
 	}
 	
-	delete iterator1;
-	delete iterator2;
-	
 	// Strings are identical so far, so compare based on string length.  Shorter
 	// string comes first
 	if (getLength() == string.getLength()) return 0;
@@ -656,37 +724,34 @@ s32 WoopsiString::indexOf(const WoopsiString& text, s32 startIndex, s32 count) c
 	s32 index = -1;
 	s32 charsExamined = 0;
 	
-	StringIterator* srciter = newStringIterator();
-	StringIterator* finditer = text.newStringIterator();
+	StringIterator srciter(this);
+	StringIterator finditer(&text);
 	
-	if (!srciter->moveTo(startIndex)) return -1;
+	if (!srciter.moveTo(startIndex)) return -1;
 
 	do {
 		bool equal = true;
-		s32 idx = srciter->getIndex();
+		s32 idx = srciter.getIndex();
 
-		finditer->moveToFirst();
+		finditer.moveToFirst();
 		
 		do {
-			if (srciter->getCodePoint() != finditer->getCodePoint()) {
+			if (srciter.getCodePoint() != finditer.getCodePoint()) {
 				equal = false;
 				break;
 			}
-		} while (finditer->moveToNext() && srciter->moveToNext());
+		} while (finditer.moveToNext() && srciter.moveToNext());
 
-		if (!srciter->moveTo(idx)) break;
+		if (!srciter.moveTo(idx)) break;
 		
-		if(equal && !finditer->moveToNext()) {
-			index = srciter->getIndex();
+		if(equal && !finditer.moveToNext()) {
+			index = srciter.getIndex();
 			break;
 		}
 		
 		charsExamined++;
-	} while (srciter->moveToNext() && (charsExamined < count));
-	
+	} while (srciter.moveToNext() && (charsExamined < count));
 	
-	delete srciter;
-	delete finditer;
 	
 	return index;
 }
@@ -708,40 +773,36 @@ s32 WoopsiString::lastIndexOf(const WoopsiString& text, s32 startIndex, s32 coun
 	s32 index = -1;
 	s32 charsExamined = 0;
 
-	StringIterator* srciter = newStringIterator();
+	StringIterator srciter(this);
 
-    if (!srciter->moveTo(startIndex)) {
-        delete srciter;
+    if (!srciter.moveTo(startIndex)) {
         return -1;
     }
 
-    StringIterator* finditer = text.newStringIterator();
+    StringIterator finditer(&text);
 
 	do {
 		bool equal = true;
-		s32 idx = srciter->getIndex();
+		s32 idx = srciter.getIndex();
 				
-		finditer->moveToLast();
+		finditer.moveToLast();
 				
 		do {
-			if (srciter->getCodePoint() != finditer->getCodePoint()) {
+			if (srciter.getCodePoint() != finditer.getCodePoint()) {
 				equal = false;
 				break;
 			}
-		} while (finditer->moveToPrevious() && srciter->moveToPrevious());
+		} while (finditer.moveToPrevious() && srciter.moveToPrevious());
 
-		if (!srciter->moveTo(idx)) break;
+		if (!srciter.moveTo(idx)) break;
 				
-		if(equal && !finditer->moveToPrevious()) {
-			index = srciter->getIndex() - text.getLength() + 1;
+		if(equal && !finditer.moveToPrevious()) {
+			index = srciter.getIndex() - text.getLength() + 1;
 			break;
 		}
 				
 		charsExamined++;
-	} while (srciter->moveToPrevious() && (charsExamined <= count));
-
-	delete srciter;
-	delete finditer;
+	} while (srciter.moveToPrevious() && (charsExamined <= count));
 	
 	return index;
 }
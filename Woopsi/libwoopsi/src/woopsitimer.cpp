@@ -6,35 +6,76 @@ WoopsiTimer::WoopsiTimer(u32 timeout, bool repeat) : Gadget(0, 0, 0, 0) {
 	_timeout = timeout;
 	_isRepeater = repeat;
 	_frameCount = 0;
+	_startTime = 0;
 	_isRunning = false;
 
 	// Ensure that Woopsi makes no attempt to draw this gadget
 	hide();
+}
 
-	// Ensure that this gadget receives VBL notifications
-	if (woopsiApplication != NULL) {
-		woopsiApplication->registerForVBL(this);
-	}
+const u32 WoopsiTimer::getFrameCount() const {
+
+	// Frames are only counted by the wheel whilst the timer is armed
+	if (isArmed()) return woopsiApplication->getTimerWheel()->getTime() - _startTime;
+
+	return _frameCount;
+}
+
+void WoopsiTimer::reset() {
+	_frameCount = 0;
+
+	if (_isRunning) arm();
 }
 
-bool WoopsiTimer::run() {
-	if (_isRunning) {
-		_frameCount++;
+void WoopsiTimer::start() {
+	if (_isRunning) return;
 
-		if (_frameCount >= _timeout) {
-			if (!_isRepeater) {
-				stop();
-			} else {
-				_frameCount = 0;
-			}
+	_isRunning = true;
+	arm();
+}
 
-			if (raisesEvents()) {
-				_gadgetEventHandler->handleActionEvent(*this);
-			}
+void WoopsiTimer::stop() {
+	_isRunning = false;
+	_frameCount = 0;
+	cancel();
+}
+
+void WoopsiTimer::pause() {
+	if (!_isRunning) return;
 
-			return true;
-		}
+	_frameCount = getFrameCount();
+	_isRunning = false;
+	cancel();
+}
+
+void WoopsiTimer::setTimeout(u32 timeout) {
+	if (_isRunning) _frameCount = getFrameCount();
+
+	_timeout = timeout;
+
+	if (_isRunning) arm();
+}
+
+void WoopsiTimer::arm() {
+
+	// Timers cannot run until Woopsi exists
+	if (woopsiApplication == NULL) return;
+
+	TimerWheel* wheel = woopsiApplication->getTimerWheel();
+
+	_startTime = wheel->getTime() - _frameCount;
+	wheel->arm(this, _timeout > _frameCount ? _timeout - _frameCount : 1);
+}
+
+void WoopsiTimer::onTimerExpired() {
+	if (!_isRepeater) {
+		stop();
+	} else {
+		_frameCount = 0;
+		arm();
 	}
 
-	return false;
+	if (raisesEvents()) {
+		_gadgetEventHandler->handleActionEvent(*this);
+	}
 }
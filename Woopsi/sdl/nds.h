@@ -15,6 +15,7 @@
 #define s8 Sint8
 #define u32 Uint32
 #define s32 Sint32
+#define u64 Uint64
 
 #define SCREEN_WIDTH 256
 #define SCREEN_HEIGHT 192